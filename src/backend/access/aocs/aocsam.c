@@ -599,6 +599,10 @@ aocs_endscan(AOCSScanDesc scan)
 
 	pfree(scan->proj_atts);
 	scan->proj_atts = NULL;
+	if (scan->lm_qual_atts)
+		pfree(scan->lm_qual_atts);
+	if (scan->lm_lazy)
+		pfree(scan->lm_lazy);
 	pfree(scan->ds);
 	scan->ds = NULL;
 
@@ -695,13 +699,293 @@ static void upgrade_datum_fetch(AOCSFetchDesc fetch, int attno, Datum values[],
 					   values, isnull, formatversion);
 }
 
+/*
+ * aocs_count_visible
+ *
+ * Computes the number of tuples a full, unqualified scan would return from
+ * the segment file tuple counts and the visibility map alone, without
+ * opening or decoding any column.  The segment files skipped here are the
+ * same ones open_next_scan_seg() skips.
+ */
+int64
+aocs_count_visible(AOCSScanDesc scan)
+{
+	bool		isSnapshotAny = (scan->snapshot == SnapshotAny);
+	int64		count = 0;
+	int			i;
+
+	for (i = 0; i < scan->total_seg; i++)
+	{
+		AOCSFileSegInfo *curSegInfo = scan->seginfo[i];
+
+		if (curSegInfo->total_tupcount <= 0 ||
+			curSegInfo->state == AOSEG_STATE_AWAITING_DROP)
+			continue;
+
+		if (scan->num_proj_atts > 0)
+		{
+			AOCSVPInfoEntry *e = getAOCSVPEntry(curSegInfo, scan->proj_atts[0]);
+
+			if (e->eof == 0)
+				continue;
+		}
+
+		count += curSegInfo->total_tupcount;
+		if (!isSnapshotAny)
+			count -= AppendOnlyVisimap_GetSegmentFileHiddenTupleCount(&scan->visibilityMap,
+																	  curSegInfo->segno);
+
+		CHECK_FOR_INTERRUPTS();
+	}
+
+	return count;
+}
+
+/*
+ * aocs_set_late_materialization
+ *
+ * Splits the projected columns into those needed by the scan qual, marked in
+ * 'qualproj', and the rest.  aocs_getnext then reads the qual columns for
+ * every row, calls 'qual' on them, and reads the other columns only for rows
+ * that pass.  Blocks of the other columns that contain no passing row are
+ * skipped without being decompressed.  Since the qual has been applied by
+ * the time aocs_getnext returns, the caller need not evaluate it again.
+ *
+ * Returns false, leaving the scan unchanged, if the qual needs none or all
+ * of the projected columns.  Must be called before the first aocs_getnext.
+ */
 bool
-aocs_getnext(AOCSScanDesc scan, ScanDirection direction, TupleTableSlot *slot)
+aocs_set_late_materialization(AOCSScanDesc scan, bool *qualproj,
+							  AOCSScanQualCallback qual, void *arg)
 {
-	int			ncol;
+	int			nqual = 0;
+	int			nlazy = 0;
+	int			i;
+
+	Assert(scan->cur_seg < 0);
+
+	for (i = 0; i < scan->num_proj_atts; i++)
+	{
+		if (qualproj[scan->proj_atts[i]])
+			nqual++;
+		else
+			nlazy++;
+	}
+
+	if (nqual == 0 || nlazy == 0)
+		return false;
+
+	scan->lm_qual_atts = palloc(nqual * sizeof(int));
+	scan->lm_lazy = palloc0(nlazy * sizeof(AOCSLazyColumn));
+	for (i = 0; i < scan->num_proj_atts; i++)
+	{
+		int			attno = scan->proj_atts[i];
+
+		if (qualproj[attno])
+			scan->lm_qual_atts[scan->num_lm_qual_atts++] = attno;
+		else
+			scan->lm_lazy[scan->num_lm_lazy++].attno = attno;
+	}
+
+	scan->lm_qual = qual;
+	scan->lm_qual_arg = arg;
+
+	return true;
+}
+
+/*
+ * Fetches the value of a late-materialized column at the given row of the
+ * current segment file.  Rows must be requested in increasing order.
+ */
+static void
+aocs_lazy_column_get(AOCSScanDesc scan, AOCSLazyColumn *col, int64 row,
+					 Datum *d, bool *null, int formatversion)
+{
+	DatumStreamRead *ds = scan->ds[col->attno];
+
+	Assert(row >= col->nextRow);
+
+	/* Step over the blocks that end before the row, reading only headers */
+	while (row >= col->blockFirstRow + col->blockRowCount)
+	{
+		if (col->state == AOCSLazyColumn_Header)
+			datumstreamread_skip_block(ds);
+
+		col->blockFirstRow += col->blockRowCount;
+		if (datumstreamread_block_header(ds) < 0)
+			ereport(ERROR,
+					(errcode(ERRCODE_INTERNAL_ERROR),
+					 errmsg("unexpected end of segment file for column %d of table \"%s\"",
+							col->attno + 1,
+							RelationGetRelationName(scan->aos_rel)),
+					 errdetail("Looking for row " INT64_FORMAT ".", row)));
+		col->state = AOCSLazyColumn_Header;
+		col->blockRowCount = ds->blockRowCount;
+
+		/*
+		 * The row count in the header of a pre-4.0 block may be too low; only
+		 * its content tells the real count.
+		 */
+		if (ds->getBlockInfo.firstRow < 0)
+		{
+			datumstreamread_block_content(ds);
+			col->state = AOCSLazyColumn_Content;
+			col->blockRowCount = ds->blockRowCount;
+		}
+		col->nextRow = col->blockFirstRow;
+	}
+
+	if (col->state != AOCSLazyColumn_Content)
+	{
+		datumstreamread_block_content(ds);
+		col->state = AOCSLazyColumn_Content;
+	}
+
+	while (col->nextRow <= row)
+	{
+		if (datumstreamread_advance(ds) == 0)
+			ereport(ERROR,
+					(errcode(ERRCODE_INTERNAL_ERROR),
+					 errmsg("unexpected end of block for column %d of table \"%s\"",
+							col->attno + 1,
+							RelationGetRelationName(scan->aos_rel)),
+					 errdetail("Looking for row " INT64_FORMAT ", block starts at row " INT64_FORMAT " and has %d rows.",
+							   row, col->blockFirstRow, col->blockRowCount)));
+		col->nextRow++;
+	}
+
+	datumstreamread_get(ds, &d[col->attno], &null[col->attno]);
+
+	if (formatversion < AORelationVersion_GetLatest())
+		upgrade_datum_scan(scan, col->attno, d, null, formatversion);
+}
+
+/*
+ * Late-materializing variant of aocs_getnext, used when
+ * aocs_set_late_materialization has been called.
+ */
+static bool
+aocs_getnext_late(AOCSScanDesc scan, TupleTableSlot *slot)
+{
+	int			ncol = slot->tts_tupleDescriptor->natts;
 	Datum	   *d = slot_get_values(slot);
 	bool	   *null = slot_get_isnull(slot);
 	AOTupleId	aoTupleId;
+	int64		rowNum;
+	int64		segRow;
+	int			err = 0;
+	int			i;
+	bool		isSnapshotAny = (scan->snapshot == SnapshotAny);
+
+	while (1)
+	{
+		AOCSFileSegInfo *curseginfo;
+
+ReadNext:
+		/* If necessary, open next seg */
+		if (scan->cur_seg < 0 || err < 0)
+		{
+			err = open_next_scan_seg(scan);
+			if (err < 0)
+			{
+				/* No more seg, we are at the end */
+				ExecClearTuple(slot);
+				scan->cur_seg = -1;
+				return false;
+			}
+			scan->cur_seg_row = 0;
+
+			for (i = 0; i < scan->num_lm_lazy; i++)
+			{
+				AOCSLazyColumn *col = &scan->lm_lazy[i];
+
+				col->state = AOCSLazyColumn_NoBlock;
+				col->blockFirstRow = 0;
+				col->blockRowCount = 0;
+				col->nextRow = 0;
+			}
+		}
+
+		Assert(scan->cur_seg >= 0);
+		curseginfo = scan->seginfo[scan->cur_seg];
+
+		/* Read the qual columns, same as aocs_getnext does for all columns */
+		rowNum = INT64CONST(-1);
+		for (i = 0; i < scan->num_lm_qual_atts; i++)
+		{
+			int			attno = scan->lm_qual_atts[i];
+
+			err = datumstreamread_advance(scan->ds[attno]);
+			Assert(err >= 0);
+			if (err == 0)
+			{
+				err = datumstreamread_block(scan->ds[attno], NULL, attno);
+				if (err < 0)
+				{
+					close_cur_scan_seg(scan);
+					goto ReadNext;
+				}
+
+				err = datumstreamread_advance(scan->ds[attno]);
+				Assert(err > 0);
+			}
+
+			datumstreamread_get(scan->ds[attno], &d[attno], &null[attno]);
+
+			if (curseginfo->formatversion < AORelationVersion_GetLatest())
+			{
+				upgrade_datum_scan(scan, attno, d, null,
+								   curseginfo->formatversion);
+			}
+
+			if (rowNum == INT64CONST(-1) &&
+				scan->ds[attno]->blockFirstRowNum != INT64CONST(-1))
+			{
+				Assert(scan->ds[attno]->blockFirstRowNum > 0);
+				rowNum = scan->ds[attno]->blockFirstRowNum +
+					datumstreamread_nth(scan->ds[attno]);
+			}
+		}
+
+		segRow = scan->cur_seg_row++;
+		if (rowNum == INT64CONST(-1))
+		{
+			AOTupleIdInit(&aoTupleId, curseginfo->segno, scan->cur_seg_row);
+		}
+		else
+		{
+			AOTupleIdInit(&aoTupleId, curseginfo->segno, rowNum);
+		}
+
+		if (!isSnapshotAny && !AppendOnlyVisimap_IsVisible(&scan->visibilityMap, &aoTupleId))
+			continue;
+		scan->cdb_fake_ctid = *((ItemPointer) &aoTupleId);
+
+		TupSetVirtualTupleNValid(slot, ncol);
+		slot_set_ctid(slot, &(scan->cdb_fake_ctid));
+
+		if (!scan->lm_qual(slot, scan->lm_qual_arg))
+			continue;
+
+		/* The row qualifies, now read the remaining columns */
+		for (i = 0; i < scan->num_lm_lazy; i++)
+			aocs_lazy_column_get(scan, &scan->lm_lazy[i], segRow, d, null,
+								 curseginfo->formatversion);
+
+		return true;
+	}
+
+	Assert(!"Never here");
+	return false;
+}
+
+bool
+aocs_getnext(AOCSScanDesc scan, ScanDirection direction, TupleTableSlot *slot)
+{
+	int			ncol;
+	Datum	   *d;
+	bool	   *null;
+	AOTupleId	aoTupleId;
 	int64		rowNum = INT64CONST(-1);
 	int			err = 0;
 	int			i;
@@ -709,6 +993,17 @@ aocs_getnext(AOCSScanDesc scan, ScanDirection direction, TupleTableSlot *slot)
 
 	Assert(ScanDirectionIsForward(direction));
 
+	/*
+	 * The block directory, if being built, needs an entry for every block,
+	 * so skipping blocks is not an option then.  The qual is still applied
+	 * below.
+	 */
+	if (scan->lm_qual && scan->blockDirectory == NULL)
+		return aocs_getnext_late(scan, slot);
+
+	d = slot_get_values(slot);
+	null = slot_get_isnull(slot);
+
 	ncol = slot->tts_tupleDescriptor->natts;
 	Assert(ncol <= scan->relationTupleDesc->natts);
 
@@ -800,6 +1095,12 @@ ReadNext:
 
 		TupSetVirtualTupleNValid(slot, ncol);
 		slot_set_ctid(slot, &(scan->cdb_fake_ctid));
+
+		if (scan->lm_qual && !scan->lm_qual(slot, scan->lm_qual_arg))
+		{
+			rowNum = INT64CONST(-1);
+			goto ReadNext;
+		}
 		return true;
 	}
 
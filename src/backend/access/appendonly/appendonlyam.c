@@ -1816,6 +1816,40 @@ appendonly_endscan(AppendOnlyScanDesc scan)
 	pfree(scan);
 }
 
+/* ----------------
+ *		appendonly_count_visible	- count the tuples a scan would return
+ *
+ * Computes the number of tuples a full, unqualified scan would return from
+ * the segment file tuple counts and the visibility map alone, without
+ * reading any data blocks.  The segment files skipped here are the same
+ * ones appendonly_getnext() skips.
+ * ----------------
+ */
+int64
+appendonly_count_visible(AppendOnlyScanDesc scan)
+{
+	bool		isSnapshotAny = (scan->snapshot == SnapshotAny);
+	int64		count = 0;
+	int			i;
+
+	for (i = 0; i < scan->aos_total_segfiles; i++)
+	{
+		FileSegInfo *fsinfo = scan->aos_segfile_arr[i];
+
+		if (fsinfo->eof == 0 || fsinfo->state == AOSEG_STATE_AWAITING_DROP)
+			continue;
+
+		count += fsinfo->total_tupcount;
+		if (!isSnapshotAny)
+			count -= AppendOnlyVisimap_GetSegmentFileHiddenTupleCount(&scan->visibilityMap,
+																	  fsinfo->segno);
+
+		CHECK_FOR_INTERRUPTS();
+	}
+
+	return count;
+}
+
 /* ----------------
  *		appendonly_getnext	- retrieve next tuple in scan
  * ----------------
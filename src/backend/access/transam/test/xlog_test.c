@@ -217,6 +217,89 @@ test_KeepLogSeg_max_slot_wal_keep_size(void **state)
 	/************************************************/
 }
 
+static void
+test_XLogFlushGroupCommitDelay_commit_delay_only(void **state)
+{
+	enableFsync = true;
+	CommitSiblings = 5;
+	CommitDelay = 10;
+	gp_dtx_group_commit_delay = 1000;
+
+	/*
+	 * Enough active backends but no other prepared transactions: the
+	 * two-phase commit delay must not be used.
+	 */
+	expect_value(MinimumActiveBackends, min, 5);
+	will_return(MinimumActiveBackends, true);
+	expect_value(MinimumPreparedXacts, min, 5);
+	will_return(MinimumPreparedXacts, false);
+
+	assert_int_equal(XLogFlushGroupCommitDelay(), 10);
+}
+
+static void
+test_XLogFlushGroupCommitDelay_dtx_delay_only(void **state)
+{
+	enableFsync = true;
+	CommitSiblings = 5;
+	CommitDelay = 1000;
+	gp_dtx_group_commit_delay = 10;
+
+	/*
+	 * Enough other prepared transactions but not enough active backends:
+	 * commit_delay must not be used.
+	 */
+	expect_value(MinimumActiveBackends, min, 5);
+	will_return(MinimumActiveBackends, false);
+	expect_value(MinimumPreparedXacts, min, 5);
+	will_return(MinimumPreparedXacts, true);
+
+	assert_int_equal(XLogFlushGroupCommitDelay(), 10);
+}
+
+static void
+test_XLogFlushGroupCommitDelay_both(void **state)
+{
+	enableFsync = true;
+	CommitSiblings = 5;
+	CommitDelay = 10;
+	gp_dtx_group_commit_delay = 1000;
+
+	expect_value(MinimumActiveBackends, min, 5);
+	will_return(MinimumActiveBackends, true);
+	expect_value(MinimumPreparedXacts, min, 5);
+	will_return(MinimumPreparedXacts, true);
+
+	assert_int_equal(XLogFlushGroupCommitDelay(), 1000);
+
+	/* the shorter delay doesn't need its condition checked */
+	CommitDelay = 1000;
+	gp_dtx_group_commit_delay = 10;
+
+	expect_value(MinimumActiveBackends, min, 5);
+	will_return(MinimumActiveBackends, true);
+
+	assert_int_equal(XLogFlushGroupCommitDelay(), 1000);
+}
+
+static void
+test_XLogFlushGroupCommitDelay_disabled(void **state)
+{
+	enableFsync = true;
+	CommitSiblings = 5;
+	CommitDelay = 0;
+	gp_dtx_group_commit_delay = 0;
+
+	assert_int_equal(XLogFlushGroupCommitDelay(), 0);
+
+	/* no delay without fsync, whatever the settings */
+	enableFsync = false;
+	CommitDelay = 10;
+	gp_dtx_group_commit_delay = 1000;
+
+	assert_int_equal(XLogFlushGroupCommitDelay(), 0);
+}
+
 int
 main(int argc, char* argv[])
 {
@@ -224,7 +307,11 @@ main(int argc, char* argv[])
 
 	const UnitTest tests[] = {
 		unit_test(test_KeepLogSeg),
-		unit_test(test_KeepLogSeg_max_slot_wal_keep_size)
+		unit_test(test_KeepLogSeg_max_slot_wal_keep_size),
+		unit_test(test_XLogFlushGroupCommitDelay_commit_delay_only),
+		unit_test(test_XLogFlushGroupCommitDelay_dtx_delay_only),
+		unit_test(test_XLogFlushGroupCommitDelay_both),
+		unit_test(test_XLogFlushGroupCommitDelay_disabled)
 	};
 	return run_tests(tests);
 }
@@ -943,6 +943,31 @@ TwoPhaseGetDummyProc(TransactionId xid)
 	return &ProcGlobal->allProcs[gxact->pgprocno];
 }
 
+/*
+ * MinimumPreparedXacts -- are at least 'min' other transactions in 2PC?
+ *
+ * Counts the transactions that are being prepared, are prepared, or are
+ * being committed or rolled back, not counting the one we hold ourselves.
+ * On a segment every writing distributed transaction flushes WAL twice on
+ * its way through this array, so this tells whether it is worth delaying a
+ * flush for others to join.  Like MinimumActiveBackends(), this is only a
+ * heuristic, so we don't acquire TwoPhaseStateLock.
+ */
+bool
+MinimumPreparedXacts(int min)
+{
+	int			count;
+
+	if (min == 0)
+		return true;
+
+	count = TwoPhaseState->numPrepXacts;
+	if (MyLockedGxact != NULL)
+		count--;
+
+	return count >= min;
+}
+
 /************************************************************************/
 /* State file support													*/
 /************************************************************************/
@@ -850,6 +850,7 @@ static Buffer RestoreBackupBlockContents(XLogRecPtr lsn, BkpBlock bkpb,
 static void AdvanceXLInsertBuffer(XLogRecPtr upto, bool opportunistic);
 static bool XLogCheckpointNeeded(XLogSegNo new_segno);
 static void XLogWrite(XLogwrtRqst WriteRqst, bool flexible);
+static int	XLogFlushGroupCommitDelay(void);
 static bool InstallXLogFileSegment(XLogSegNo *segno, char *tmppath,
 					   bool find_free, int *max_advance,
 					   bool use_lock);
@@ -2955,6 +2956,7 @@ XLogFlush(XLogRecPtr record)
 		/* use volatile pointer to prevent code rearrangement */
 		volatile XLogCtlData *xlogctl = XLogCtl;
 		XLogRecPtr	insertpos;
+		int			delay;
 
 		/* read LogwrtResult and update local state */
 		SpinLockAcquire(&xlogctl->info_lck);
@@ -3006,11 +3008,15 @@ XLogFlush(XLogRecPtr record)
 		 *
 		 * We do not sleep if enableFsync is not turned on, nor if there are
 		 * fewer than CommitSiblings other backends with active transactions.
+		 *
+		 * In Greenplum, gp_dtx_group_commit_delay does the same for the
+		 * PREPARE and COMMIT PREPARED records of distributed transactions;
+		 * see XLogFlushGroupCommitDelay().
 		 */
-		if (CommitDelay > 0 && enableFsync &&
-			MinimumActiveBackends(CommitSiblings))
+		delay = XLogFlushGroupCommitDelay();
+		if (delay > 0)
 		{
-			pg_usleep(CommitDelay);
+			pg_usleep(delay);
 
 			/*
 			 * Re-check how far we can now flush the WAL. It's generally not
@@ -3069,6 +3075,35 @@ XLogFlush(XLogRecPtr record)
 		   (uint32) (LogwrtResult.Flush >> 32), (uint32) LogwrtResult.Flush);
 }
 
+/*
+ * How long XLogFlush() should sleep before flushing, so that commit records
+ * of other backends can join the flush.
+ *
+ * commit_delay applies when at least commit_siblings other backends have a
+ * transaction open.  The backends writing COMMIT PREPARED records on a
+ * segment have no XID of their own and are not counted by that, so
+ * gp_dtx_group_commit_delay applies instead when at least commit_siblings
+ * other transactions are in two-phase commit.  Each delay is used only when
+ * its own condition holds; when both do, the longer one is used.
+ */
+static int
+XLogFlushGroupCommitDelay(void)
+{
+	int			delay = 0;
+
+	if (!enableFsync)
+		return 0;
+
+	if (CommitDelay > 0 && MinimumActiveBackends(CommitSiblings))
+		delay = CommitDelay;
+
+	if (gp_dtx_group_commit_delay > delay &&
+		MinimumPreparedXacts(CommitSiblings))
+		delay = gp_dtx_group_commit_delay;
+
+	return delay;
+}
+
 /*
  * Flush xlog, but without specifying exactly where to flush to.
  *
@@ -22,6 +22,7 @@
 #include "cdb/cdbappendonlyxlog.h"
 #include "cdb/cdbbufferedappend.h"
 #include "utils/guc.h"
+#include "utils/resgroup.h"
 
 static void BufferedAppendWrite(
 					BufferedAppend *bufferedAppend,
@@ -171,6 +172,9 @@ BufferedAppendWrite(BufferedAppend *bufferedAppend, bool needsWAL)
 	Assert(bufferedAppend->largeWriteLen > 0);
 	largeWriteMemory = bufferedAppend->largeWriteMemory;
 
+	/* wait here if the resource group is over its io_write_limit */
+	ResGroupThrottleIO(bufferedAppend->largeWriteLen, true);
+
 	bytestotal = 0;
 	bytesleft = bufferedAppend->largeWriteLen;
 	while (bytesleft > 0)
@@ -18,6 +18,7 @@
 
 #include "cdb/cdbbufferedread.h"
 #include "utils/guc.h"
+#include "utils/resgroup.h"
 #include "miscadmin.h"
 
 static void BufferedReadIo(
@@ -191,6 +192,9 @@ BufferedReadIo(
 	}
 #endif
 
+	/* wait here if the resource group is over its io_read_limit */
+	ResGroupThrottleIO(largeReadLen, false);
+
 	offset = 0;
 	while (largeReadLen > 0)
 	{
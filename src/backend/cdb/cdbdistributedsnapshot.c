@@ -29,6 +29,93 @@ GetMaxSnapshotDistributedXidCount()
 	return GetMaxSnapshotXidCount();
 }
 
+/*
+ * The in-progress xids of a distributed snapshot are dispatched with every
+ * statement and slice.  They are sorted, and with many concurrent
+ * transactions close to each other, so they are sent as variable-length
+ * deltas from the previous xid (starting from xmin) using 7 bits per byte.
+ * The deltas are computed modulo 2^32, so an unsorted array still round-trips,
+ * just less compactly.
+ */
+#define XID_DELTA_MAX_BYTES 5
+
+static inline int
+xid_delta_size(uint32 delta)
+{
+	int			len = 1;
+
+	while (delta >= 0x80)
+	{
+		delta >>= 7;
+		len++;
+	}
+	return len;
+}
+
+static inline int
+xid_delta_encode(uint32 delta, char *buf)
+{
+	unsigned char *p = (unsigned char *) buf;
+
+	while (delta >= 0x80)
+	{
+		*p++ = (unsigned char) (delta | 0x80);
+		delta >>= 7;
+	}
+	*p++ = (unsigned char) delta;
+
+	return (char *) p - buf;
+}
+
+static inline int
+xid_delta_decode(const char *buf, uint32 *delta)
+{
+	const unsigned char *p = (const unsigned char *) buf;
+	uint32		result = 0;
+	int			shift = 0;
+
+	for (;;)
+	{
+		unsigned char b = *p++;
+
+		result |= (uint32) (b & 0x7F) << shift;
+		if ((b & 0x80) == 0)
+			break;
+		shift += 7;
+		if (shift >= 7 * XID_DELTA_MAX_BYTES)
+			elog(ERROR, "invalid distributed snapshot in-progress xid encoding");
+	}
+	*delta = result;
+
+	return (const char *) p - buf;
+}
+
+/*
+ * Is distribXid in the sorted in-progress array of the distributed snapshot?
+ */
+static bool
+DistributedSnapshot_XidInProgress(DistributedSnapshot *ds,
+								  DistributedTransactionId distribXid)
+{
+	int32		low = 0;
+	int32		high = ds->count - 1;
+
+	while (low <= high)
+	{
+		int32		mid = low + (high - low) / 2;
+		DistributedTransactionId xid = ds->inProgressXidArray[mid];
+
+		if (distribXid == xid)
+			return true;
+		if (distribXid < xid)
+			high = mid - 1;
+		else
+			low = mid + 1;
+	}
+
+	return false;
+}
+
 /*
  * DistributedSnapshotWithLocalMapping_CommittedTest
  *		Is the given XID still-in-progress according to the
@@ -190,46 +277,41 @@ DistributedSnapshotWithLocalMapping_CommittedTest(
 		return DISTRIBUTEDSNAPSHOT_COMMITTED_INPROGRESS;
 	}
 
-	for (i = 0; i < ds->count; i++)
+	/*
+	 * ds->inProgressXidArray is sorted in ascending order based on
+	 * distribXid while creating the snapshot in CreateDistributedSnapshot(),
+	 * so it can be binary searched.  With thousands of concurrent
+	 * transactions this check runs for every tuple whose visibility isn't
+	 * settled yet.
+	 */
+	if (DistributedSnapshot_XidInProgress(ds, distribXid))
 	{
-		if (distribXid == ds->inProgressXidArray[i])
+		/*
+		 * Save the relationship to the local xid so we may avoid checking
+		 * the distributed committed log in a subsequent check. We can only
+		 * record local xids till cache size permits.
+		 */
+		if (dslm->currentLocalXidsCount < dslm->maxLocalXidsCount)
 		{
-			/*
-			 * Save the relationship to the local xid so we may avoid checking
-			 * the distributed committed log in a subsequent check. We can
-			 * only record local xids till cache size permits.
-			 */
-			if (dslm->currentLocalXidsCount < dslm->maxLocalXidsCount)
-			{
-				Assert(dslm->inProgressMappedLocalXids != NULL);
-
-				dslm->inProgressMappedLocalXids[dslm->currentLocalXidsCount++] =
-					localXid;
+			Assert(dslm->inProgressMappedLocalXids != NULL);
 
-				if (!TransactionIdIsValid(dslm->minCachedLocalXid) ||
-					TransactionIdPrecedes(localXid, dslm->minCachedLocalXid))
-				{
-					dslm->minCachedLocalXid = localXid;
-				}
+			dslm->inProgressMappedLocalXids[dslm->currentLocalXidsCount++] =
+				localXid;
 
-				if (!TransactionIdIsValid(dslm->maxCachedLocalXid) ||
-					TransactionIdFollows(localXid, dslm->maxCachedLocalXid))
-				{
-					dslm->maxCachedLocalXid = localXid;
-				}
+			if (!TransactionIdIsValid(dslm->minCachedLocalXid) ||
+				TransactionIdPrecedes(localXid, dslm->minCachedLocalXid))
+			{
+				dslm->minCachedLocalXid = localXid;
 			}
 
-			return DISTRIBUTEDSNAPSHOT_COMMITTED_INPROGRESS;
+			if (!TransactionIdIsValid(dslm->maxCachedLocalXid) ||
+				TransactionIdFollows(localXid, dslm->maxCachedLocalXid))
+			{
+				dslm->maxCachedLocalXid = localXid;
+			}
 		}
 
-		/*
-		 * Leverage the fact that ds->inProgressXidArray is sorted in
-		 * ascending order based on distribXid while creating the snapshot in
-		 * CreateDistributedSnapshot(). So, can fail fast once known are
-		 * lower than rest of them.
-		 */
-		if (distribXid < ds->inProgressXidArray[i])
-			break;
+		return DISTRIBUTEDSNAPSHOT_COMMITTED_INPROGRESS;
 	}
 
 	/*
@@ -327,20 +409,33 @@ DistributedSnapshot_Copy(DistributedSnapshot *target,
 int
 DistributedSnapshot_SerializeSize(DistributedSnapshot *ds)
 {
-	return sizeof(DistributedTransactionTimeStamp) +
+	int			size;
+	DistributedTransactionId prev = ds->xmin;
+	int32		i;
+
+	size = sizeof(DistributedTransactionTimeStamp) +
 		sizeof(DistributedSnapshotId) +
 	/* xminAllDistributedSnapshots, xmin, xmax */
 		3 * sizeof(DistributedTransactionId) +
 	/* count */
-		sizeof(int32) +
-	/* Size of inProgressXidArray */
-		sizeof(DistributedTransactionId) * ds->count;
+		sizeof(int32);
+
+	/* Size of the delta-encoded inProgressXidArray */
+	for (i = 0; i < ds->count; i++)
+	{
+		size += xid_delta_size(ds->inProgressXidArray[i] - prev);
+		prev = ds->inProgressXidArray[i];
+	}
+
+	return size;
 }
 
 int
 DistributedSnapshot_Serialize(DistributedSnapshot *ds, char *buf)
 {
 	char	   *p = buf;
+	DistributedTransactionId prev;
+	int32		i;
 
 	memcpy(p, &ds->distribTransactionTimeStamp, sizeof(DistributedTransactionTimeStamp));
 	p += sizeof(DistributedTransactionTimeStamp);
@@ -355,8 +450,12 @@ DistributedSnapshot_Serialize(DistributedSnapshot *ds, char *buf)
 	memcpy(p, &ds->count, sizeof(int32));
 	p += sizeof(int32);
 
-	memcpy(p, ds->inProgressXidArray, sizeof(DistributedTransactionId) * ds->count);
-	p += sizeof(DistributedTransactionId) * ds->count;
+	prev = ds->xmin;
+	for (i = 0; i < ds->count; i++)
+	{
+		p += xid_delta_encode(ds->inProgressXidArray[i] - prev, p);
+		prev = ds->inProgressXidArray[i];
+	}
 
 	Assert((p - buf) == DistributedSnapshot_SerializeSize(ds));
 
@@ -415,13 +514,19 @@ DistributedSnapshot_Deserialize(const char *buf, DistributedSnapshot *ds)
 
 	if (count > 0)
 	{
-		int			xipsize;
+		DistributedTransactionId prev = ds->xmin;
+		int32		i;
 
 		Assert(ds->inProgressXidArray != NULL);
 
-		xipsize = sizeof(DistributedTransactionId) * count;
-		memcpy(ds->inProgressXidArray, p, xipsize);
-		p += xipsize;
+		for (i = 0; i < count; i++)
+		{
+			uint32		delta;
+
+			p += xid_delta_decode(p, &delta);
+			prev += delta;
+			ds->inProgressXidArray[i] = prev;
+		}
 	}
 	ds->count = count;
 
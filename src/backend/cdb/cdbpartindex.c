@@ -20,6 +20,7 @@
 #include "catalog/index.h"
 #include "catalog/indexing.h"
 #include "catalog/pg_constraint.h"
+#include "catalog/pg_partition.h"
 #include "catalog/pg_partition_rule.h"
 #include "cdb/cdbpartition.h"
 #include "cdb/partitionselection.h"
@@ -1039,6 +1040,91 @@ get_relation_part_constraints(Oid rootOid, List **defaultLevels)
 	return allCons;
 }
 
+/*
+ * get_relation_part_default_levels
+ *  return the partitioning levels that have a default partition, for a
+ *  partitioned table given the oid of the root.
+ *
+ *  This is the defaultLevels output of get_relation_part_constraints,
+ *  without fetching and merging the constraints of every part. Only
+ *  pg_partition_rule is read, and the scan of a level stops at its first
+ *  default partition.
+ */
+List *
+get_relation_part_default_levels(Oid rootOid)
+{
+	List	   *defaultLevels = NIL;
+
+	if (!rel_is_partitioned(rootOid))
+	{
+		return NIL;
+	}
+
+	/* get number of partitioning levels */
+	List	   *partkeys = rel_partition_keys_ordered(rootOid);
+	int			nLevels = list_length(partkeys);
+
+	list_free(partkeys);
+
+	Relation	partRel = heap_open(PartitionRelationId, AccessShareLock);
+	Relation	ruleRel = heap_open(PartitionRuleRelationId, AccessShareLock);
+
+	for (int level = 0; level < nLevels; level++)
+	{
+		ScanKeyData scankey[3];
+		SysScanDesc sscan;
+		HeapTuple	tuple;
+		Oid			paroid = InvalidOid;
+
+		ScanKeyInit(&scankey[0],
+					Anum_pg_partition_parrelid,
+					BTEqualStrategyNumber, F_OIDEQ,
+					ObjectIdGetDatum(rootOid));
+		ScanKeyInit(&scankey[1],
+					Anum_pg_partition_parlevel,
+					BTEqualStrategyNumber, F_INT2EQ,
+					Int16GetDatum(level));
+		ScanKeyInit(&scankey[2],
+					Anum_pg_partition_paristemplate,
+					BTEqualStrategyNumber, F_BOOLEQ,
+					BoolGetDatum(false));
+		sscan = systable_beginscan(partRel, PartitionParrelidParlevelParistemplateIndexId, true,
+								   NULL, 3, scankey);
+		tuple = systable_getnext(sscan);
+		if (HeapTupleIsValid(tuple))
+		{
+			paroid = HeapTupleGetOid(tuple);
+		}
+		systable_endscan(sscan);
+
+		if (!OidIsValid(paroid))
+		{
+			continue;
+		}
+
+		ScanKeyInit(&scankey[0],
+					Anum_pg_partition_rule_paroid,
+					BTEqualStrategyNumber, F_OIDEQ,
+					ObjectIdGetDatum(paroid));
+		sscan = systable_beginscan(ruleRel, PartitionRuleParoidParparentruleParruleordIndexId, true,
+								   NULL, 1, scankey);
+		while (HeapTupleIsValid(tuple = systable_getnext(sscan)))
+		{
+			if (((Form_pg_partition_rule) GETSTRUCT(tuple))->parisdefault)
+			{
+				defaultLevels = lappend_int(defaultLevels, level);
+				break;
+			}
+		}
+		systable_endscan(sscan);
+	}
+
+	heap_close(ruleRel, AccessShareLock);
+	heap_close(partRel, AccessShareLock);
+
+	return defaultLevels;
+}
+
 /*
  * get_leaf_part_constraints
  *  return the leaf part constraints for a partitioned table given its oid
@@ -142,7 +142,8 @@ static void
 			handlePollError(CdbDispatchCmdAsync *pParms);
 
 static void
-			handlePollSuccess(CdbDispatchCmdAsync *pParms, struct pollfd *fds);
+			handlePollSuccess(CdbDispatchCmdAsync *pParms, struct pollfd *fds,
+							  int *fdOwners, int nfds);
 
 static bool
 			checkAckMessage(CdbDispatchResult *dispatchResult, const char *message);
@@ -451,12 +452,28 @@ checkDispatchResult(CdbDispatcherState *ds, int timeout_sec)
 	int			timeout = 0;
 	bool		sentSignal = false;
 	struct pollfd *fds;
+	int		   *fdOwners;
+	int		   *pending;
+	int			npending;
+	int			done_ack_count = 0;
 	uint8 ftsVersion = 0;
 	struct timeval start_ts, now;
 	int64		diff_us;
 
 	db_count = pParms->dispatchCount;
 	fds = (struct pollfd *) palloc(db_count * sizeof(struct pollfd));
+	fdOwners = (int *) palloc(db_count * sizeof(int));
+
+	/*
+	 * Indexes of the QEs that may still send results to us.  On a large
+	 * cluster most QEs are done long before the last one answers, so the
+	 * finished ones are dropped from this set instead of being rescanned
+	 * after every poll().
+	 */
+	pending = (int *) palloc(db_count * sizeof(int));
+	for (i = 0; i < db_count; i++)
+		pending[i] = i;
+	npending = db_count;
 
 #ifdef FAULT_INJECTOR
 	if (SIMPLE_FAULT_INJECTOR("alloc_chunk_during_dispatch") == FaultInjectorTypeSkip)
@@ -472,8 +489,10 @@ checkDispatchResult(CdbDispatcherState *ds, int timeout_sec)
 	{
 		int			sock;
 		int			n;
+		int			j;
 		int			nfds = 0;
-		int			ack_count = 0;
+		int			npending_next = 0;
+		int			ack_count = done_ack_count;
 		PGconn		*conn;
 
 		/*
@@ -501,8 +520,9 @@ checkDispatchResult(CdbDispatcherState *ds, int timeout_sec)
 		/*
 		 * Which QEs are still running and could send results to us?
 		 */
-		for (i = 0; i < db_count; i++)
+		for (j = 0; j < npending; j++)
 		{
+			i = pending[j];
 			dispatchResult = pParms->dispatchResultPtrArray[i];
 			segdbDesc = dispatchResult->segdbDesc;
 			conn = segdbDesc->conn;
@@ -511,6 +531,12 @@ checkDispatchResult(CdbDispatcherState *ds, int timeout_sec)
 				checkAckMessage(dispatchResult, pParms->ackMessage))
 			{
 				ack_count++;
+
+				/* a finished QE can't take back its ack */
+				if (dispatchResult->stillRunning)
+					pending[npending_next++] = i;
+				else
+					done_ack_count++;
 				continue;
 			}
 
@@ -541,6 +567,7 @@ checkDispatchResult(CdbDispatcherState *ds, int timeout_sec)
 #ifdef FAULT_INJECTOR
 			/* inject invalid sock to simulate an pqFlush() error */
 			static int saved_sock = -1;
+			bool		restore_sock = false;
 			if (FaultInjector_InjectFaultIfSet("inject_invalid_sock_for_checkDispatchResult",
 						DDLNotSpecified,
 						"" /* databaseName */,
@@ -552,7 +579,7 @@ checkDispatchResult(CdbDispatcherState *ds, int timeout_sec)
 					conn->sock = -1;
 					strlcpy(conn->errorMessage.data, "inject invalid sock\n", conn->errorMessage.maxlen);
 					conn->errorMessage.len = strlen(conn->errorMessage.data);
-					i--;
+					restore_sock = true;
 				}
 			}
 #endif
@@ -567,13 +594,14 @@ checkDispatchResult(CdbDispatcherState *ds, int timeout_sec)
 					segdbDesc->whoami, PQerrorMessage(conn));
 				dispatchResult->stillRunning = false;
 #ifdef FAULT_INJECTOR
-				/* restore the saved sock */
-				if (i == -1)
+				/* restore the saved sock, and look at this QE again */
+				if (restore_sock)
 				{
 					conn->sock = saved_sock;
 					conn->errorMessage.data[0] = '\0';
 					conn->errorMessage.len = 0;
 					dispatchResult->stillRunning = true;
+					j--;
 				}
 #endif
 				continue;
@@ -586,8 +614,12 @@ checkDispatchResult(CdbDispatcherState *ds, int timeout_sec)
 			Assert(sock >= 0);
 			fds[nfds].fd = sock;
 			fds[nfds].events = POLLIN;
+			fdOwners[nfds] = i;
 			nfds++;
+
+			pending[npending_next++] = i;
 		}
+		npending = npending_next;
 
 		/*
 		 * Break out when no QEs still running or required QEs acked.
@@ -682,9 +714,11 @@ checkDispatchResult(CdbDispatcherState *ds, int timeout_sec)
 		}
 		/* We have data waiting on one or more of the connections. */
 		else
-			handlePollSuccess(pParms, fds);
+			handlePollSuccess(pParms, fds, fdOwners, nfds);
 	}
 
+	pfree(pending);
+	pfree(fdOwners);
 	pfree(fds);
 }
 
@@ -825,44 +859,34 @@ handlePollError(CdbDispatchCmdAsync *pParms)
  */
 static void
 handlePollSuccess(CdbDispatchCmdAsync *pParms,
-				  struct pollfd *fds)
+				  struct pollfd *fds, int *fdOwners, int nfds)
 {
-	int			currentFdNumber = 0;
-	int			i = 0;
+	int			currentFdNumber;
 
 	/*
-	 * We have data waiting on one or more of the connections.
+	 * We have data waiting on one or more of the connections. Only the QEs
+	 * that were polled need to be looked at, fdOwners maps each polled
+	 * socket back to its QE.
 	 */
-	for (i = 0; i < pParms->dispatchCount; i++)
+	for (currentFdNumber = 0; currentFdNumber < nfds; currentFdNumber++)
 	{
 		bool		finished;
-		int			sock;
+		int			i = fdOwners[currentFdNumber];
 		CdbDispatchResult *dispatchResult = pParms->dispatchResultPtrArray[i];
 		SegmentDatabaseDescriptor *segdbDesc = dispatchResult->segdbDesc;
 
+		Assert(dispatchResult->stillRunning);
+		Assert(PQsocket(segdbDesc->conn) == fds[currentFdNumber].fd);
+
 		/*
-		 * Skip if already finished or didn't dispatch.
+		 * Skip this connection if it has no input available.
 		 */
-		if (!dispatchResult->stillRunning)
-			continue;
-
-		if (pParms->waitMode == DISPATCH_WAIT_ACK_ROOT &&
-				 dispatchResult->receivedAckMsg)
+		if (!(fds[currentFdNumber].revents & POLLIN))
 			continue;
 
 		ELOG_DISPATCHER_DEBUG("looking for results from %d of %d (%s)",
 							  i + 1, pParms->dispatchCount, segdbDesc->whoami);
 
-		sock = PQsocket(segdbDesc->conn);
-		Assert(sock >= 0);
-		Assert(sock == fds[currentFdNumber].fd);
-
-		/*
-		 * Skip this connection if it has no input available.
-		 */
-		if (!(fds[currentFdNumber++].revents & POLLIN))
-			continue;
-
 		ELOG_DISPATCHER_DEBUG("PQsocket says there are results from %d of %d (%s)",
 							  i + 1, pParms->dispatchCount, segdbDesc->whoami);
 
@@ -121,12 +121,18 @@ create_gang_retry:
 
 	PG_TRY();
 	{
+		/*
+		 * The GUC options are the same for every QE of the gang, build them
+		 * once when the first connection is started rather than walking all
+		 * the GUCs for each of the segments.
+		 */
+		char	   *options = NULL;
+		char	   *diff_options = NULL;
+
 		for (i = 0; i < size; i++)
 		{
 			bool		ret;
 			char		gpqeid[100];
-			char	   *options = NULL;
-			char	   *diff_options = NULL;
 
 			/*
 			 * Create the connection requests.	If we find a segment without a
@@ -161,7 +167,8 @@ create_gang_retry:
 						(errcode(ERRCODE_GP_INTERCONNECTION_ERROR),
 						 errmsg("failed to construct connectionstring")));
 
-			makeOptions(&options, &diff_options);
+			if (options == NULL)
+				makeOptions(&options, &diff_options);
 
 			/* start connection in asynchronous way */
 			cdbconn_doConnectStart(segdbDesc, gpqeid, options, diff_options);
@@ -181,6 +188,13 @@ create_gang_retry:
 			pollingStatus[i] = PGRES_POLLING_WRITING;
 		}
 
+		/* libpq keeps its own copy of the connection options */
+		if (options != NULL)
+		{
+			pfree(options);
+			pfree(diff_options);
+		}
+
 		/*
 		 * Ok, we've now launched all the connection attempts. Start the
 		 * timeout clock (= get the start timestamp), and poll until they're
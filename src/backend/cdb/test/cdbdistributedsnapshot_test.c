@@ -166,6 +166,83 @@ test__DistributedSnapshotWithLocalMapping_CommittedTest(void **state)
 	free(dslm.inProgressMappedLocalXids);
 }
 
+static void
+check_serialize_roundtrip(DistributedSnapshot *ds)
+{
+	DistributedSnapshot copy;
+	char	   *buf;
+	int			size;
+	int			i;
+
+	size = DistributedSnapshot_SerializeSize(ds);
+	buf = malloc(size);
+	assert_int_equal(DistributedSnapshot_Serialize(ds, buf), size);
+
+	memset(&copy, 0, sizeof(copy));
+	assert_int_equal(DistributedSnapshot_Deserialize(buf, &copy), size);
+
+	assert_true(copy.distribTransactionTimeStamp == ds->distribTransactionTimeStamp);
+	assert_true(copy.xminAllDistributedSnapshots == ds->xminAllDistributedSnapshots);
+	assert_true(copy.distribSnapshotId == ds->distribSnapshotId);
+	assert_true(copy.xmin == ds->xmin);
+	assert_true(copy.xmax == ds->xmax);
+	assert_int_equal(copy.count, ds->count);
+	for (i = 0; i < ds->count; i++)
+		assert_true(copy.inProgressXidArray[i] == ds->inProgressXidArray[i]);
+
+	free(copy.inProgressXidArray);
+	free(buf);
+}
+
+static void
+test__DistributedSnapshot_Serialize(void **state)
+{
+	DistributedSnapshot ds;
+	int			fixedSize;
+
+	ds.inProgressXidArray =
+		(DistributedTransactionId*)malloc(SIZE_OF_IN_PROGRESS_ARRAY);
+	ds.maxCount = 10;
+	ds.distribTransactionTimeStamp = time(NULL);
+	ds.distribSnapshotId = 12345;
+	ds.xminAllDistributedSnapshots = 90;
+	ds.xmin = 100;
+	ds.xmax = 100;
+	ds.count = 0;
+
+	/* no in-progress transactions */
+	check_serialize_roundtrip(&ds);
+	fixedSize = DistributedSnapshot_SerializeSize(&ds);
+
+	/* nearby xids take one byte each */
+	ds.xmax = 400;
+	ds.count = 4;
+	ds.inProgressXidArray[0] = 100;
+	ds.inProgressXidArray[1] = 101;
+	ds.inProgressXidArray[2] = 150;
+	ds.inProgressXidArray[3] = 227;
+	check_serialize_roundtrip(&ds);
+	assert_int_equal(DistributedSnapshot_SerializeSize(&ds), fixedSize + 4);
+
+	/* larger gaps take more bytes, but still round-trip */
+	ds.xmax = 0xFFFFFFF0;
+	ds.count = 3;
+	ds.inProgressXidArray[0] = 100 + 128;
+	ds.inProgressXidArray[1] = 100 + 128 + 70000;
+	ds.inProgressXidArray[2] = 0xFFFFFFEF;
+	check_serialize_roundtrip(&ds);
+	assert_int_equal(DistributedSnapshot_SerializeSize(&ds), fixedSize + 2 + 3 + 5);
+
+	/* an unsorted array round-trips too */
+	ds.count = 3;
+	ds.inProgressXidArray[0] = 300;
+	ds.inProgressXidArray[1] = 200;
+	ds.inProgressXidArray[2] = 250;
+	check_serialize_roundtrip(&ds);
+
+	free(ds.inProgressXidArray);
+}
+
 int
 main(int argc, char* argv[])
 {
@@ -173,7 +250,8 @@ main(int argc, char* argv[])
 
 	const UnitTest tests[] =
 	{
-		unit_test(test__DistributedSnapshotWithLocalMapping_CommittedTest)
+		unit_test(test__DistributedSnapshotWithLocalMapping_CommittedTest),
+		unit_test(test__DistributedSnapshot_Serialize)
 	};
 
 	MemoryContextInit();
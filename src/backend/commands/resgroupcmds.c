@@ -45,6 +45,8 @@
 #define RESGROUP_DEFAULT_MEM_SPILL_RATIO RESGROUP_FALLBACK_MEMORY_SPILL_RATIO
 #define RESGROUP_DEFAULT_MEMORY_LIMIT RESGROUP_UNLIMITED_MEMORY_LIMIT
 
+#define RESGROUP_DEFAULT_IO_LIMIT RESGROUP_UNLIMITED_IO_LIMIT
+
 #define RESGROUP_DEFAULT_MEM_AUDITOR (RESGROUP_MEMORY_AUDITOR_VMTRACKER)
 #define RESGROUP_INVALID_MEM_AUDITOR (-1)
 
@@ -63,6 +65,10 @@
 #define RESGROUP_MIN_MEMORY_SPILL_RATIO		(0)
 #define RESGROUP_MAX_MEMORY_SPILL_RATIO		(100)
 
+/* io_read_limit and io_write_limit are in MB/s per segment */
+#define RESGROUP_MIN_IO_LIMIT	(0)
+#define RESGROUP_MAX_IO_LIMIT	(1024 * 1024)
+
 /*
  * The names must be in the same order as ResGroupMemAuditorType.
  */
@@ -489,6 +495,12 @@ AlterResourceGroup(AlterResourceGroupStmt *stmt)
 			StrNCpy(caps.cpuset, cpuset, sizeof(caps.cpuset));
 			caps.cpuRateLimit = CPU_RATE_LIMIT_DISABLED;
 			break;
+		case RESGROUP_LIMIT_TYPE_IO_READ_LIMIT:
+			caps.ioReadLimit = value;
+			break;
+		case RESGROUP_LIMIT_TYPE_IO_WRITE_LIMIT:
+			caps.ioWriteLimit = value;
+			break;
 		default:
 			break;
 	}
@@ -638,6 +650,14 @@ GetResGroupCapabilities(Relation rel, Oid groupId, ResGroupCaps *resgroupCaps)
 			case RESGROUP_LIMIT_TYPE_CPUSET:
 				StrNCpy(resgroupCaps->cpuset, value, sizeof(resgroupCaps->cpuset));
 				break;
+			case RESGROUP_LIMIT_TYPE_IO_READ_LIMIT:
+				resgroupCaps->ioReadLimit = str2Int(value,
+													getResgroupOptionName(type));
+				break;
+			case RESGROUP_LIMIT_TYPE_IO_WRITE_LIMIT:
+				resgroupCaps->ioWriteLimit = str2Int(value,
+													 getResgroupOptionName(type));
+				break;
 			default:
 				break;
 		}
@@ -841,6 +861,10 @@ getResgroupOptionType(const char* defname)
 		return RESGROUP_LIMIT_TYPE_MEMORY_AUDITOR;
 	else if (strcmp(defname, "cpuset") == 0)
 		return RESGROUP_LIMIT_TYPE_CPUSET;
+	else if (strcmp(defname, "io_read_limit") == 0)
+		return RESGROUP_LIMIT_TYPE_IO_READ_LIMIT;
+	else if (strcmp(defname, "io_write_limit") == 0)
+		return RESGROUP_LIMIT_TYPE_IO_WRITE_LIMIT;
 	else
 		return RESGROUP_LIMIT_TYPE_UNKNOWN;
 }
@@ -896,6 +920,10 @@ getResgroupOptionName(ResGroupLimitType type)
 			return "memory_auditor";
 		case RESGROUP_LIMIT_TYPE_CPUSET:
 			return "cpuset";
+		case RESGROUP_LIMIT_TYPE_IO_READ_LIMIT:
+			return "io_read_limit";
+		case RESGROUP_LIMIT_TYPE_IO_WRITE_LIMIT:
+			return "io_write_limit";
 		default:
 			return "unknown";
 	}
@@ -968,6 +996,18 @@ checkResgroupCapLimit(ResGroupLimitType type, int value)
 								   ResGroupMemAuditorName[RESGROUP_MEMORY_AUDITOR_CGROUP])));
 				break;
 
+			case RESGROUP_LIMIT_TYPE_IO_READ_LIMIT:
+			case RESGROUP_LIMIT_TYPE_IO_WRITE_LIMIT:
+				if (value < RESGROUP_MIN_IO_LIMIT ||
+					value > RESGROUP_MAX_IO_LIMIT)
+					ereport(ERROR,
+							(errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+							errmsg("%s range is [%d, %d]",
+								   getResgroupOptionName(type),
+								   RESGROUP_MIN_IO_LIMIT,
+								   RESGROUP_MAX_IO_LIMIT)));
+				break;
+
 			default:
 				Assert(!"unexpected options");
 				break;
@@ -1080,6 +1120,12 @@ parseStmtOptions(CreateResourceGroupStmt *stmt, ResGroupCaps *caps)
 				case RESGROUP_LIMIT_TYPE_MEMORY_AUDITOR:
 					caps->memAuditor = value;
 					break;
+				case RESGROUP_LIMIT_TYPE_IO_READ_LIMIT:
+					caps->ioReadLimit = value;
+					break;
+				case RESGROUP_LIMIT_TYPE_IO_WRITE_LIMIT:
+					caps->ioWriteLimit = value;
+					break;
 				default:
 					break;
 			}
@@ -1116,6 +1162,12 @@ parseStmtOptions(CreateResourceGroupStmt *stmt, ResGroupCaps *caps)
 	if (!(mask & (1 << RESGROUP_LIMIT_TYPE_MEMORY_AUDITOR)))
 		caps->memAuditor = RESGROUP_DEFAULT_MEM_AUDITOR;
 
+	if (!(mask & (1 << RESGROUP_LIMIT_TYPE_IO_READ_LIMIT)))
+		caps->ioReadLimit = RESGROUP_DEFAULT_IO_LIMIT;
+
+	if (!(mask & (1 << RESGROUP_LIMIT_TYPE_IO_WRITE_LIMIT)))
+		caps->ioWriteLimit = RESGROUP_DEFAULT_IO_LIMIT;
+
 	checkResgroupCapConflicts(caps);
 }
 
@@ -1214,6 +1266,24 @@ insertResgroupCapabilities(Relation rel, Oid groupId, ResGroupCaps *caps)
 
 	insertResgroupCapabilityEntry(rel, groupId,
 								  RESGROUP_LIMIT_TYPE_CPUSET, caps->cpuset);
+
+	/*
+	 * The io limits are only stored when set, a missing entry means
+	 * unlimited, the same as for groups created before they existed.
+	 */
+	if (caps->ioReadLimit != RESGROUP_UNLIMITED_IO_LIMIT)
+	{
+		sprintf(value, "%d", caps->ioReadLimit);
+		insertResgroupCapabilityEntry(rel, groupId,
+									  RESGROUP_LIMIT_TYPE_IO_READ_LIMIT, value);
+	}
+
+	if (caps->ioWriteLimit != RESGROUP_UNLIMITED_IO_LIMIT)
+	{
+		sprintf(value, "%d", caps->ioWriteLimit);
+		insertResgroupCapabilityEntry(rel, groupId,
+									  RESGROUP_LIMIT_TYPE_IO_WRITE_LIMIT, value);
+	}
 }
 
 /*
@@ -1254,6 +1324,15 @@ updateResgroupCapabilityEntry(Relation rel,
 	MemSet(isnull, 0, sizeof(isnull));
 	MemSet(repl, 0, sizeof(repl));
 
+	if (limitType == RESGROUP_LIMIT_TYPE_CPUSET)
+	{
+		StrNCpy(stringBuffer, strValue, sizeof(stringBuffer));
+	}
+	else
+	{
+		snprintf(stringBuffer, sizeof(stringBuffer), "%d", value);
+	}
+
 	oldTuple = systable_getnext(sscan);
 	if (!HeapTupleIsValid(oldTuple))
 	{
@@ -1261,25 +1340,17 @@ updateResgroupCapabilityEntry(Relation rel,
 		 * It's possible for a cap to be missing, e.g. a resgroup is created
 		 * with v5.0 which does not support cap=7 (cpuset), then we binary
 		 * switch to v5.10 and alter it, then we'll find cap=7 missing here.
-		 * Instead of raising an error we should fallback to insert a new cap.
+		 * The io limits are also only stored once they are set.  Instead of
+		 * raising an error we should fallback to insert a new cap.
 		 */
 
 		systable_endscan(sscan);
 
-		insertResgroupCapabilityEntry(rel, groupId, limitType, (char *) strValue);
+		insertResgroupCapabilityEntry(rel, groupId, limitType, stringBuffer);
 
 		return;
 	}
 
-	if (limitType == RESGROUP_LIMIT_TYPE_CPUSET)
-	{
-		StrNCpy(stringBuffer, strValue, sizeof(stringBuffer));
-	}
-	else
-	{
-		snprintf(stringBuffer, sizeof(stringBuffer), "%d", value);
-	}
-
 	values[Anum_pg_resgroupcapability_value - 1] = CStringGetTextDatum(stringBuffer);
 	isnull[Anum_pg_resgroupcapability_value - 1] = false;
 	repl[Anum_pg_resgroupcapability_value - 1]  = true;
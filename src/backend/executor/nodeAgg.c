@@ -128,6 +128,7 @@
 #include "executor/executor.h"
 #include "executor/execHHashagg.h"
 #include "executor/nodeAgg.h"
+#include "executor/nodeSeqscan.h"
 #include "lib/stringinfo.h"             /* StringInfo */
 #include "miscadmin.h"
 #include "nodes/makefuncs.h"
@@ -188,6 +189,8 @@ static Bitmapset *find_unaggregated_cols(AggState *aggstate);
 static bool find_unaggregated_cols_walker(Node *node, Bitmapset **colnos);
 static void clear_agg_object(AggState *aggstate);
 static TupleTableSlot *agg_retrieve_direct(AggState *aggstate);
+static bool agg_can_count_from_scan(AggState *aggstate);
+static TupleTableSlot *agg_retrieve_scan_count(AggState *aggstate);
 static TupleTableSlot *agg_retrieve_hash_table(AggState *aggstate);
 static void ExecAggExplainEnd(PlanState *planstate, struct StringInfoData *buf);
 static void ExecEagerFreeAgg(AggState *node);
@@ -1239,6 +1242,8 @@ ExecAgg(AggState *node)
 			}
 		}
 	}
+	else if (node->count_from_scan)
+		return agg_retrieve_scan_count(node);
 	else
 		return agg_retrieve_direct(node);
 }
@@ -1725,6 +1730,120 @@ agg_retrieve_direct(AggState *aggstate)
 	return NULL;
 }
 
+/*
+ * ExecAgg for plain count(*) over an unqualified append-optimized scan.
+ *
+ * The number of rows the scan would return is known from the segment file
+ * tuple counts and the visibility map, so we install it directly as the
+ * transition value of every count(*) instead of pulling the tuples through
+ * advance_aggregates().  See agg_can_count_from_scan().
+ */
+static TupleTableSlot *
+agg_retrieve_scan_count(AggState *aggstate)
+{
+	Agg		   *node = (Agg *) aggstate->ss.ps.plan;
+	ExprContext *econtext = aggstate->ss.ps.ps_ExprContext;
+	AggStatePerAgg peragg = aggstate->peragg;
+	AggStatePerGroup pergroup = aggstate->pergroup;
+	MemoryContext oldContext;
+	int64		count;
+	int			aggno;
+
+	while (!aggstate->agg_done)
+	{
+		ReScanExprContext(econtext);
+		MemoryContextResetAndDeleteChildren(aggstate->aggcontext);
+		clear_agg_object(aggstate);
+		initialize_aggregates(aggstate, peragg, pergroup);
+
+		count = ExecSeqScanCountTuples((SeqScanState *) outerPlanState(aggstate));
+		aggstate->agg_done = true;
+
+		/* int8 may be pass-by-reference, so build it in the aggcontext */
+		oldContext = MemoryContextSwitchTo(aggstate->aggcontext);
+		for (aggno = 0; aggno < aggstate->numaggs; aggno++)
+		{
+			pergroup[aggno].transValue = Int64GetDatum(count);
+			pergroup[aggno].transValueIsNull = false;
+			pergroup[aggno].noTransValue = false;
+		}
+		MemoryContextSwitchTo(oldContext);
+
+		/* No grouping, so there are no references to input columns */
+		econtext->ecxt_outertuple = aggstate->ss.ss_ScanTupleSlot;
+
+		for (aggno = 0; aggno < aggstate->numaggs; aggno++)
+			finalize_aggregate(aggstate, &peragg[aggno], &pergroup[aggno],
+							   &econtext->ecxt_aggvalues[aggno],
+							   &econtext->ecxt_aggnulls[aggno]);
+
+		econtext->group_id = node->rollupGSTimes;
+		econtext->grouping = node->grouping;
+
+		if (ExecQual(aggstate->ss.ps.qual, econtext, false))
+		{
+			TupleTableSlot *result;
+			ExprDoneCond isDone;
+
+			result = ExecProject(aggstate->ss.ps.ps_ProjInfo, &isDone);
+
+			if (isDone != ExprEndResult)
+			{
+				aggstate->ps_TupFromTlist =
+					(isDone == ExprMultipleResult);
+				return result;
+			}
+		}
+		else
+			InstrCountFiltered1(aggstate, 1);
+	}
+
+	return NULL;
+}
+
+/*
+ * Can this Agg take its result from agg_retrieve_scan_count()?
+ *
+ * That requires an ungrouped Agg whose aggregates are all plain count(*),
+ * computed directly (or as the partial stage of a two-stage aggregation)
+ * over a SeqScan that can count its tuples without reading them.
+ */
+static bool
+agg_can_count_from_scan(AggState *aggstate)
+{
+	Agg		   *node = (Agg *) aggstate->ss.ps.plan;
+	PlanState  *outerPlan = outerPlanState(aggstate);
+	int			aggno;
+
+	if (!gp_enable_ao_count_pushdown)
+		return false;
+
+	if (node->aggstrategy != AGG_PLAIN || node->numCols > 0 ||
+		node->inputHasGrouping || aggstate->numaggs == 0)
+		return false;
+
+	if (outerPlan == NULL || !IsA(outerPlan, SeqScanState) ||
+		!ExecSeqScanCanCountTuples((SeqScanState *) outerPlan))
+		return false;
+
+	for (aggno = 0; aggno < aggstate->numaggs; aggno++)
+	{
+		Aggref	   *aggref = aggstate->peragg[aggno].aggref;
+
+		if (aggref->aggfnoid != COUNT_STAR_OID ||
+			aggref->aggdistinct != NIL ||
+			aggref->aggorder != NIL ||
+			aggref->aggfilter != NULL)
+			return false;
+
+		if (aggref->aggstage != AGGSTAGE_NORMAL &&
+			aggref->aggstage != AGGSTAGE_PARTIAL)
+			return false;
+	}
+
+	return true;
+}
+
 /*
  * ExecAgg for hashed case: phase 2, retrieving groups from hash table
  */
@@ -2498,6 +2617,8 @@ ExecInitAgg(Agg *node, EState *estate, int eflags)
 
 	aggstate->num_attrs = 0;
 
+	aggstate->count_from_scan = agg_can_count_from_scan(aggstate);
+
 	/* Set the default memory manager */
 	aggstate->mem_manager.alloc = cxt_alloc;
 	aggstate->mem_manager.free = cxt_free;
@@ -25,7 +25,7 @@
 #include "executor/execdebug.h"
 #include "executor/execUtils.h"
 #include "executor/nodeMotion.h"
-#include "lib/binaryheap.h"
+#include "lib/losertree.h"
 #include "utils/tuplesort.h"
 #include "utils/tuplesort_mk_details.h"
 #include "miscadmin.h"
@@ -48,7 +48,7 @@
 /*
  * CdbTupleHeapInfo
  *
- * A priority queue element holding the next tuple of the
+ * A loser tree element holding the next tuple of the
  * sorted tuple stream received from a particular sender.
  * Used by sorted receiver (Merge Receive).
  */
@@ -108,7 +108,7 @@ static TupleTableSlot *execMotionSortedReceiver_mk(MotionState *node);
 
 static void execMotionSortedReceiverFirstTime(MotionState *node);
 
-static int	CdbMergeComparator(Datum lhs, Datum rhs, void *context);
+static int	CdbMergeComparator(int lSegIdx, int rSegIdx, void *context);
 static uint32 evalHashKey(ExprContext *econtext, List *hashkeys, CdbHash *h);
 
 static void doSendEndOfStream(Motion *motion, MotionState *node);
@@ -632,6 +632,18 @@ destroy_motion_mk_heap(MotionState *node)
 	 */
 }
 
+/*
+ * Sorted receiver using an mk heap (gp_enable_motion_mk_sort).
+ *
+ * This path deliberately keeps the mk heap rather than the loser tree used by
+ * execMotionSortedReceiver().  The mk heap compares each entry against the
+ * heap top one sort key at a time and remembers the level at which they
+ * differ (lvtops), so a replacement tuple usually only has its leading keys
+ * fetched and compared.  That bookkeeping is relative to a single top entry
+ * and has no equivalent for the pairwise matches stored in a loser tree;
+ * switching would give up the key-level savings for multi-key orderings,
+ * which is what this receiver exists for.
+ */
 static TupleTableSlot *
 execMotionSortedReceiver_mk(MotionState *node)
 {
@@ -698,12 +710,12 @@ execMotionSortedReceiver_mk(MotionState *node)
 	return slot;
 }
 
-/* Sorted receiver using binary heap */
+/* Sorted receiver using a loser tree */
 static TupleTableSlot *
 execMotionSortedReceiver(MotionState *node)
 {
 	TupleTableSlot *slot;
-	binaryheap *hp = node->tupleheap;
+	losertree  *lt = node->tupleheap;
 	GenericTuple tuple,
 				inputTuple;
 	Motion	   *motion = (Motion *) node->ps.plan;
@@ -712,7 +724,7 @@ execMotionSortedReceiver(MotionState *node)
 
 	AssertState(motion->motionType == MOTIONTYPE_FIXED &&
 				motion->sendSorted &&
-				hp != NULL);
+				lt != NULL);
 
 	/* Notify senders and return EOS if caller doesn't want any more data. */
 	if (node->stopRequested)
@@ -749,20 +761,20 @@ execMotionSortedReceiver(MotionState *node)
 			ereport(ERROR, (errmsg("Interconnect is down unexpectedly.")));
 	}
 
-	/* On first call, fill the priority queue with each sender's first tuple. */
+	/* On first call, fill the loser tree with each sender's first tuple. */
 	if (!node->tupleheapReady)
 	{
 		execMotionSortedReceiverFirstTime(node);
 	}
 
 	/*
-	 * Delete from the priority queue the element that we fetched last time.
-	 * Receive and insert the next tuple from that same sender.
+	 * Replace the element that we fetched last time with the next tuple
+	 * received from that same sender.
 	 */
 	else
 	{
-		/* Old element is still at the head of the pq. */
-		Assert(DatumGetInt32(binaryheap_first(hp)) == node->routeIdNext);
+		/* Old element is still the winner of the tournament. */
+		Assert(losertree_first(lt) == node->routeIdNext);
 
 		/* Receive the successor of the tuple that we returned last time. */
 		inputTuple = RecvTupleFrom(node->ps.state->motionlayer_context,
@@ -770,7 +782,7 @@ execMotionSortedReceiver(MotionState *node)
 								   motion->motionID,
 								   node->routeIdNext);
 
-		/* Substitute it in the pq for its predecessor. */
+		/* Substitute it in the tree for its predecessor. */
 		if (inputTuple)
 		{
 			CdbTupleHeapInfo *info = &node->tupleheap_entries[node->routeIdNext];
@@ -789,7 +801,7 @@ execMotionSortedReceiver(MotionState *node)
 											node->tupleheap_cxt->tupDesc,
 											&info->isnull1);
 
-			binaryheap_replace_first(hp, Int32GetDatum(node->routeIdNext));
+			losertree_replace_first(lt);
 
 			node->numTuplesFromAMS++;
 
@@ -812,13 +824,13 @@ execMotionSortedReceiver(MotionState *node)
 		}
 		else
 		{
-			/* At EOS, drop this sender from the priority queue. */
-			binaryheap_remove_first(hp);
+			/* At EOS, drop this sender from the tournament. */
+			losertree_remove_first(lt);
 		}
 	}
 
 	/* Finished if all senders have returned EOS. */
-	if (binaryheap_empty(hp))
+	if (losertree_empty(lt))
 	{
 		Assert(node->numTuplesFromAMS == node->numTuplesToParent);
 		Assert(node->numTuplesFromChild == 0);
@@ -827,19 +839,18 @@ execMotionSortedReceiver(MotionState *node)
 	}
 
 	/*
-	 * Our next result tuple, with lowest key among all senders, is now at the
-	 * head of the priority queue.  Get it from there.
+	 * Our next result tuple, with lowest key among all senders, is now the
+	 * winner of the tournament.  Get it from there.
 	 *
-	 * We transfer ownership of the tuple from the pq element to our caller,
-	 * but the pq element itself will remain in place until the next time we
-	 * are called, to avoid an unnecessary rearrangement of the priority
-	 * queue.
+	 * We transfer ownership of the tuple from the tree element to our caller,
+	 * but the sender remains the winner until the next time we are called,
+	 * when its successor replays the matches on its path to the root.
 	 */
-	node->routeIdNext = binaryheap_first(hp);
+	node->routeIdNext = losertree_first(lt);
 	tupHeapInfo = &node->tupleheap_entries[node->routeIdNext];
 	tuple = tupHeapInfo->tuple;
 
-	/* Zap dangling tuple ptr for safety. PQ element doesn't own it anymore. */
+	/* Zap dangling tuple ptr for safety. Tree element doesn't own it anymore. */
 	tupHeapInfo->tuple = NULL;
 
 	/* Update counters. */
@@ -875,7 +886,7 @@ void
 execMotionSortedReceiverFirstTime(MotionState *node)
 {
 	GenericTuple inputTuple;
-	binaryheap *hp = node->tupleheap;
+	losertree  *lt = node->tupleheap;
 	Motion	   *motion = (Motion *) node->ps.plan;
 	int			iSegIdx;
 	ListCell   *lcProcess;
@@ -886,7 +897,7 @@ execMotionSortedReceiverFirstTime(MotionState *node)
 	Assert(sendSlice->sliceIndex == motion->motionID);
 
 	/*
-	 * Get the first tuple from every sender, and stick it into the heap.
+	 * Get the first tuple from every sender, and enter it in the tournament.
 	 */
 	foreach_with_count(lcProcess, sendSlice->primaryProcesses, iSegIdx)
 	{
@@ -907,7 +918,7 @@ execMotionSortedReceiverFirstTime(MotionState *node)
 
 			info->tuple = inputTuple;
 
-			binaryheap_add_unordered(hp, iSegIdx);
+			losertree_add_unordered(lt, iSegIdx);
 
 			if (is_memtuple(inputTuple))
 				info->datum1 = memtuple_getattr((MemTuple) inputTuple,
@@ -943,11 +954,11 @@ execMotionSortedReceiverFirstTime(MotionState *node)
 	Assert(iSegIdx == node->numInputSegs);
 
 	/*
-	 * Done adding the elements, now arrange the heap to satisfy the heap
-	 * property. This is quicker than inserting the initial elements one by
-	 * one.
+	 * Done adding the elements, now play the initial tournament.  This takes
+	 * one comparison per sender; afterwards every tuple we return costs only
+	 * log2(numInputSegs) comparisons to replace.
 	 */
-	binaryheap_build(hp);
+	losertree_build(lt);
 
 	node->tupleheapReady = true;
 }								/* execMotionSortedReceiverFirstTime */
@@ -1177,7 +1188,7 @@ ExecInitMotion(Motion *node, EState *estate, int eflags)
 		motionstate->cdbhash = makeCdbHash(numsegments, nkeys, node->hashFuncs);
 	}
 
-	/* Merge Receive: Set up the key comparator and priority queue. */
+	/* Merge Receive: Set up the key comparator and tournament tree. */
 	if (node->sendSorted && motionstate->mstype == MOTIONSTATE_RECV)
 	{
 		if (gp_enable_motion_mk_sort)
@@ -1187,7 +1198,7 @@ ExecInitMotion(Motion *node, EState *estate, int eflags)
 			/* Allocate context object for the key comparator. */
 			motionstate->tupleheap_entries =
 				palloc(motionstate->numInputSegs * sizeof(CdbTupleHeapInfo));
-			/* Create the priority queue structure. */
+			/* Create the loser tree structure. */
 			motionstate->tupleheap_cxt =
 				CdbMergeComparator_CreateContext(motionstate->tupleheap_entries,
 												 tupDesc,
@@ -1197,9 +1208,9 @@ ExecInitMotion(Motion *node, EState *estate, int eflags)
 												 node->collations,
 												 node->nullsFirst);
 			motionstate->tupleheap =
-				binaryheap_allocate(motionstate->numInputSegs,
-									CdbMergeComparator,
-									motionstate->tupleheap_cxt);
+				losertree_allocate(motionstate->numInputSegs,
+								   CdbMergeComparator,
+								   motionstate->tupleheap_cxt);
 		}
 	}
 
@@ -1306,10 +1317,10 @@ ExecEndMotion(MotionState *node)
 	}
 #endif							/* MEASURE_MOTION_TIME */
 
-	/* Merge Receive: Free the priority queue and associated structures. */
+	/* Merge Receive: Free the loser tree and associated structures. */
 	if (node->tupleheap != NULL)
 	{
-		binaryheap_free(node->tupleheap);
+		losertree_free(node->tupleheap);
 
 		CdbMergeComparator_DestroyContext(node->tupleheap_cxt);
 		node->tupleheap = NULL;
@@ -1359,10 +1370,8 @@ ExecEndMotion(MotionState *node)
  * Used to compare tuples for a sorted motion node.
  */
 static int
-CdbMergeComparator(Datum lhs, Datum rhs, void *context)
+CdbMergeComparator(int lSegIdx, int rSegIdx, void *context)
 {
-	int			lSegIdx = DatumGetInt32(lhs);
-	int			rSegIdx = DatumGetInt32(rhs);
 	CdbMergeComparatorContext *ctx = (CdbMergeComparatorContext *) context;
 	CdbTupleHeapInfo *linfo = (CdbTupleHeapInfo *) &ctx->tupleheap_entries[lSegIdx];
 	CdbTupleHeapInfo *rinfo = (CdbTupleHeapInfo *) &ctx->tupleheap_entries[rSegIdx];
@@ -27,16 +27,21 @@
 #include "access/relscan.h"
 #include "executor/execdebug.h"
 #include "executor/nodeSeqscan.h"
+#include "optimizer/clauses.h"
 #include "utils/rel.h"
 
 #include "cdb/cdbappendonlyam.h"
 #include "cdb/cdbaocsam.h"
+#include "cdb/cdbvars.h"
+#include "miscadmin.h"
 #include "utils/snapmgr.h"
 
 static void InitScanRelation(SeqScanState *node, EState *estate, int eflags, Relation currentRelation);
 static TupleTableSlot *SeqNext(SeqScanState *node);
 
 static void InitAOCSScanOpaque(SeqScanState *scanState, Relation currentRelation);
+static void InitAOCSLateMaterialization(SeqScanState *node);
+static bool SeqScanAOCSQual(TupleTableSlot *slot, void *arg);
 
 /* ----------------------------------------------------------------
  *						Scan Support
@@ -132,6 +137,49 @@ ExecSeqScan(SeqScanState *node)
 					(ExecScanRecheckMtd) SeqRecheck);
 }
 
+/* ----------------------------------------------------------------
+ *		ExecSeqScanCanCountTuples
+ *
+ *		Can the number of tuples this scan will return be computed
+ *		without running it?  That is the case for an unqualified scan
+ *		of an append-optimized table, whose visible tuple count follows
+ *		from the segment file metadata and the visibility map.  The
+ *		targetlist must not have volatile functions either, as GPORCA
+ *		puts projections such as nextval() into it and they must run
+ *		once per tuple.
+ * ----------------------------------------------------------------
+ */
+bool
+ExecSeqScanCanCountTuples(SeqScanState *node)
+{
+	if (node->ss.ps.plan->qual != NIL)
+		return false;
+
+	if (contain_volatile_functions((Node *) node->ss.ps.plan->targetlist))
+		return false;
+
+	return (node->ss_currentScanDesc_ao != NULL ||
+			node->ss_currentScanDesc_aocs != NULL);
+}
+
+/* ----------------------------------------------------------------
+ *		ExecSeqScanCountTuples
+ *
+ *		Returns the number of tuples the scan would return, without
+ *		reading any data.  Only valid if ExecSeqScanCanCountTuples().
+ * ----------------------------------------------------------------
+ */
+int64
+ExecSeqScanCountTuples(SeqScanState *node)
+{
+	Assert(ExecSeqScanCanCountTuples(node));
+
+	if (node->ss_currentScanDesc_ao)
+		return appendonly_count_visible(node->ss_currentScanDesc_ao);
+	else
+		return aocs_count_visible(node->ss_currentScanDesc_aocs);
+}
+
 /* ----------------------------------------------------------------
  *		InitScanRelation
  *
@@ -184,6 +232,9 @@ InitScanRelation(SeqScanState *node, EState *estate, int eflags, Relation curren
 						   appendOnlyMetaDataSnapshot,
 						   NULL /* relationTupleDesc */,
 						   node->ss_aocs_proj);
+
+		if (gp_enable_aocs_late_materialization)
+			InitAOCSLateMaterialization(node);
 	}
 	else
 	{
@@ -396,3 +447,55 @@ InitAOCSScanOpaque(SeqScanState *scanstate, Relation currentRelation)
 	scanstate->ss_aocs_ncol = ncol;
 	scanstate->ss_aocs_proj = proj;
 }
+
+/*
+ * If the scan has a qual, let the AOCS scan evaluate it on the qual columns
+ * before reading the others, so that those are only decoded for rows that
+ * pass.  The qual is then taken away from ExecScan, which would otherwise
+ * evaluate it a second time.
+ *
+ * Not done in an EvalPlanQual recheck, where ExecScan applies the qual to
+ * the test tuple without calling SeqNext.
+ */
+static void
+InitAOCSLateMaterialization(SeqScanState *node)
+{
+	bool	   *qualproj;
+	int			ncol = node->ss_aocs_ncol;
+
+	if (node->ss.ps.qual == NIL || node->ss.ps.state->es_epqTuple != NULL)
+		return;
+
+	qualproj = palloc0(ncol * sizeof(bool));
+	GetNeededColumnsForScan((Node *) node->ss.ps.plan->qual, qualproj, ncol);
+
+	if (aocs_set_late_materialization(node->ss_currentScanDesc_aocs, qualproj,
+									  SeqScanAOCSQual, node))
+	{
+		node->ss_aocs_qual = node->ss.ps.qual;
+		node->ss.ps.qual = NIL;
+	}
+
+	pfree(qualproj);
+}
+
+/*
+ * Qual callback for late materialization, see InitAOCSLateMaterialization.
+ */
+static bool
+SeqScanAOCSQual(TupleTableSlot *slot, void *arg)
+{
+	SeqScanState *node = (SeqScanState *) arg;
+	ExprContext *econtext = node->ss.ps.ps_ExprContext;
+
+	CHECK_FOR_INTERRUPTS();
+
+	ResetExprContext(econtext);
+	econtext->ecxt_scantuple = slot;
+
+	if (ExecQual(node->ss_aocs_qual, econtext, false))
+		return true;
+
+	InstrCountFiltered1(node, 1);
+	return false;
+}
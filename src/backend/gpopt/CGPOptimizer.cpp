@@ -15,6 +15,7 @@
 
 #include "gpopt/CGPOptimizer.h"
 
+#include "gpopt/utils/CMemoryPoolArenaManager.h"
 #include "gpopt/utils/CMemoryPoolPalloc.h"
 #include "gpopt/utils/CMemoryPoolPallocManager.h"
 #include "gpopt/utils/COptTasks.h"
@@ -183,7 +184,11 @@ CGPOptimizer::SerializeDXLPlan(Query *query)
 void
 CGPOptimizer::InitGPOPT()
 {
-	if (optimizer_use_gpdb_allocators)
+	if (optimizer_use_gpdb_allocators && optimizer_use_arena_memory_pools)
+	{
+		CMemoryPoolArenaManager::Init();
+	}
+	else if (optimizer_use_gpdb_allocators)
 	{
 		CMemoryPoolPallocManager::Init();
 	}
@@ -839,6 +839,18 @@ gpdb::GetRelationPartContraints(Oid rel_oid, List **default_levels)
 	return NULL;
 }
 
+List *
+gpdb::GetRelationPartDefaultLevels(Oid rel_oid)
+{
+	GP_WRAP_START;
+	{
+		/* catalog tables: pg_partition, pg_partition_rule */
+		return get_relation_part_default_levels(rel_oid);
+	}
+	GP_WRAP_END;
+	return NIL;
+}
+
 Node *
 gpdb::GetLeafPartContraints(Oid rel_oid, List **default_levels)
 {
@@ -2615,6 +2627,31 @@ gpdb::MDCacheNeedsReset(void)
 	return true;
 }
 
+char *
+gpdb::SharedMDCacheLookup(int mdtype, const char *mdid, Size *len,
+						  OrcaMDCacheVersion *version)
+{
+	GP_WRAP_START;
+	{
+		return OrcaMDCacheLookup(mdtype, mdid, len, version);
+	}
+	GP_WRAP_END;
+	return NULL;
+}
+
+void
+gpdb::SharedMDCacheInsert(int mdtype, const char *mdid,
+						  const OrcaMDCacheVersion *version, const char *data,
+						  Size len)
+{
+	GP_WRAP_START;
+	{
+		OrcaMDCacheInsert(mdtype, mdid, version, data, len);
+		return;
+	}
+	GP_WRAP_END;
+}
+
 // returns true if a query cancel is requested in GPDB
 bool
 gpdb::IsAbortRequested(void)
@@ -17,11 +17,16 @@
 extern "C" {
 #include "postgres.h"
 }
+#include "gpopt/gpdbwrappers.h"
 #include "gpopt/mdcache/CMDAccessor.h"
 #include "gpopt/relcache/CMDProviderRelcache.h"
 #include "gpopt/translate/CTranslatorRelcacheToDXL.h"
+#include "gpopt/translate/CTranslatorUtils.h"
 #include "naucrates/dxl/CDXLUtils.h"
 #include "naucrates/exception.h"
+#include "naucrates/md/CMDIdGPDB.h"
+#include "naucrates/md/IMDColStats.h"
+#include "naucrates/md/IMDRelStats.h"
 
 using namespace gpos;
 using namespace gpdxl;
@@ -45,6 +50,48 @@ CMDProviderRelcache::GetMDObjDXLStr(CMemoryPool *mp, CMDAccessor *md_accessor,
 									IMDId *md_id,
 									IMDCacheObject::Emdtype mdtype) const
 {
+	// CTAS objects have a fixed id, so they must never be shared
+	BOOL use_shared_cache = (IMDId::EmdidGPDBCtas != md_id->MdidType());
+	CHAR *mdid_str = NULL;
+	OrcaMDCacheVersion version;
+
+	if (use_shared_cache)
+	{
+		mdid_str = CTranslatorUtils::CreateMultiByteCharStringFromWCString(
+			md_id->GetBuffer());
+
+		Size len = 0;
+		CHAR *data =
+			gpdb::SharedMDCacheLookup(mdtype, mdid_str, &len, &version);
+		if (NULL != data)
+		{
+			CWStringDynamic *str =
+				GPOS_NEW(m_mp) CWStringDynamic(m_mp, (const WCHAR *) data);
+			gpdb::GPDBFree(data);
+			gpdb::GPDBFree(mdid_str);
+
+			// whether a relation is supported depends on session settings
+			// such as optimizer_multilevel_partitioning, so check it again
+			// for the relation that another session cached
+			if (IMDCacheObject::EmdtRel == mdtype)
+			{
+				GPOS_TRY
+				{
+					CTranslatorRelcacheToDXL::CheckUnsupportedRelation(
+						CMDIdGPDB::CastMdid(md_id)->Oid());
+				}
+				GPOS_CATCH_EX(ex)
+				{
+					GPOS_DELETE(str);
+					GPOS_RETHROW(ex);
+				}
+				GPOS_CATCH_END;
+			}
+
+			return str;
+		}
+	}
+
 	IMDCacheObject *md_obj = CTranslatorRelcacheToDXL::RetrieveObject(
 		mp, md_accessor, md_id, mdtype);
 
@@ -53,9 +100,36 @@ CMDProviderRelcache::GetMDObjDXLStr(CMemoryPool *mp, CMDAccessor *md_accessor,
 	CWStringDynamic *str = CDXLUtils::SerializeMDObj(
 		m_mp, md_obj, true /*fSerializeHeaders*/, false /*findent*/);
 
+	// The row count of a table that has never been analyzed or vacuumed is
+	// estimated from its current size, which changes without any catalog
+	// update. Keep such statistics out of the shared cache.
+	if (IMDCacheObject::EmdtRelStats == md_obj->MDType())
+	{
+		use_shared_cache =
+			use_shared_cache &&
+			0 < dynamic_cast<IMDRelStats *>(md_obj)->RelPages();
+	}
+	else if (IMDCacheObject::EmdtColStats == md_obj->MDType())
+	{
+		use_shared_cache =
+			use_shared_cache &&
+			!dynamic_cast<IMDColStats *>(md_obj)->IsColStatsMissing();
+	}
+
 	// cleanup DXL object
 	md_obj->Release();
 
+	if (use_shared_cache)
+	{
+		gpdb::SharedMDCacheInsert(mdtype, mdid_str, &version,
+								  (const char *) str->GetBuffer(),
+								  (str->Length() + 1) * GPOS_SIZEOF(WCHAR));
+	}
+	if (NULL != mdid_str)
+	{
+		gpdb::GPDBFree(mdid_str);
+	}
+
 	return str;
 }
 
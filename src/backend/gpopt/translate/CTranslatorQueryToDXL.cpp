@@ -1610,10 +1610,7 @@ CTranslatorQueryToDXL::TranslateWindowSpecToDXL(
 
 		if (NULL != wc->name)
 		{
-			CWStringDynamic *alias_str =
-				CDXLUtils::CreateDynamicStringFromCharArray(m_mp, wc->name);
-			mdname = GPOS_NEW(m_mp) CMDName(m_mp, alias_str);
-			GPOS_DELETE(alias_str);
+			mdname = CDXLUtils::CreateMDNameFromCharArray(m_mp, wc->name);
 		}
 
 		if (0 < gpdb::ListLength(wc->orderClause))
@@ -3460,11 +3457,8 @@ CTranslatorQueryToDXL::TranslateValueScanRTEToDXL(const RangeTblEntry *rte,
 
 				colid = m_context->m_colid_counter->next_id();
 
-				CWStringDynamic *alias_str =
-					CDXLUtils::CreateDynamicStringFromCharArray(
-						m_mp, col_name_char_array);
-				CMDName *mdname = GPOS_NEW(m_mp) CMDName(m_mp, alias_str);
-				GPOS_DELETE(alias_str);
+				CMDName *mdname = CDXLUtils::CreateMDNameFromCharArray(
+					m_mp, col_name_char_array);
 
 				CDXLColDescr *dxl_col_descr = GPOS_NEW(m_mp) CDXLColDescr(
 					m_mp, mdname, colid, col_pos_idx + 1 /* attno */,
@@ -3493,11 +3487,8 @@ CTranslatorQueryToDXL::TranslateValueScanRTEToDXL(const RangeTblEntry *rte,
 
 				if (0 == tuple_pos)
 				{
-					CWStringDynamic *alias_str =
-						CDXLUtils::CreateDynamicStringFromCharArray(
-							m_mp, col_name_char_array);
-					CMDName *mdname = GPOS_NEW(m_mp) CMDName(m_mp, alias_str);
-					GPOS_DELETE(alias_str);
+					CMDName *mdname = CDXLUtils::CreateMDNameFromCharArray(
+						m_mp, col_name_char_array);
 
 					CDXLColDescr *dxl_col_descr = GPOS_NEW(m_mp) CDXLColDescr(
 						m_mp, mdname, colid, col_pos_idx + 1 /* attno */,
@@ -4190,11 +4181,8 @@ CTranslatorQueryToDXL::CreateDXLProjectNullsForGroupingSets(
 			}
 			else
 			{
-				CWStringDynamic *alias_str =
-					CDXLUtils::CreateDynamicStringFromCharArray(
-						m_mp, target_entry->resname);
-				mdname_alias = GPOS_NEW(m_mp) CMDName(m_mp, alias_str);
-				GPOS_DELETE(alias_str);
+				mdname_alias = CDXLUtils::CreateMDNameFromCharArray(
+					m_mp, target_entry->resname);
 			}
 			CDXLNode *project_elem_dxlnode = GPOS_NEW(m_mp) CDXLNode(
 				m_mp,
@@ -4290,11 +4278,8 @@ CTranslatorQueryToDXL::CreateDXLProjectGroupingFuncs(
 			}
 			else
 			{
-				CWStringDynamic *alias_str =
-					CDXLUtils::CreateDynamicStringFromCharArray(
-						m_mp, target_entry->resname);
-				mdname_alias = GPOS_NEW(m_mp) CMDName(m_mp, alias_str);
-				GPOS_DELETE(alias_str);
+				mdname_alias = CDXLUtils::CreateMDNameFromCharArray(
+					m_mp, target_entry->resname);
 			}
 			CDXLNode *project_elem_dxlnode = GPOS_NEW(m_mp) CDXLNode(
 				m_mp,
@@ -4382,12 +4367,8 @@ CTranslatorQueryToDXL::CreateDXLOutputCols(
 		}
 		else
 		{
-			CWStringDynamic *alias_str =
-				CDXLUtils::CreateDynamicStringFromCharArray(
-					m_mp, target_entry->resname);
-			mdname = GPOS_NEW(m_mp) CMDName(m_mp, alias_str);
-			// CName constructor copies string
-			GPOS_DELETE(alias_str);
+			mdname = CDXLUtils::CreateMDNameFromCharArray(
+				m_mp, target_entry->resname);
 		}
 
 		const ULONG colid =
@@ -4441,10 +4422,7 @@ CTranslatorQueryToDXL::TranslateExprToDXLProject(Expr *expr,
 	}
 	else
 	{
-		CWStringDynamic *alias_str =
-			CDXLUtils::CreateDynamicStringFromCharArray(m_mp, alias_name);
-		mdname_alias = GPOS_NEW(m_mp) CMDName(m_mp, alias_str);
-		GPOS_DELETE(alias_str);
+		mdname_alias = CDXLUtils::CreateMDNameFromCharArray(m_mp, alias_name);
 	}
 
 	if (IsA(expr, Var) && !insist_new_colids)
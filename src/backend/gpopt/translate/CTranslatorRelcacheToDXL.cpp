@@ -237,10 +237,7 @@ CTranslatorRelcacheToDXL::GetRelName(CMemoryPool *mp, Relation rel)
 {
 	GPOS_ASSERT(NULL != rel);
 	CHAR *relname = NameStr(rel->rd_rel->relname);
-	CWStringDynamic *relname_str =
-		CDXLUtils::CreateDynamicStringFromCharArray(mp, relname);
-	CMDName *mdname = GPOS_NEW(mp) CMDName(mp, relname_str);
-	GPOS_DELETE(relname_str);
+	CMDName *mdname = CDXLUtils::CreateMDNameFromCharArray(mp, relname);
 	return mdname;
 }
 
@@ -1142,10 +1139,7 @@ CTranslatorRelcacheToDXL::RetrieveIndex(CMemoryPool *mp,
 
 		// get the index name
 		CHAR *index_name = NameStr(index_rel->rd_rel->relname);
-		CWStringDynamic *str_name =
-			CDXLUtils::CreateDynamicStringFromCharArray(mp, index_name);
-		mdname = GPOS_NEW(mp) CMDName(mp, str_name);
-		GPOS_DELETE(str_name);
+		mdname = CDXLUtils::CreateMDNameFromCharArray(mp, index_name);
 
 		Relation table =
 			gpdb::GetRelation(CMDIdGPDB::CastMdid(md_rel->MDId())->Oid());
@@ -1899,12 +1893,7 @@ CTranslatorRelcacheToDXL::RetrieveFunc(CMemoryPool *mp, IMDId *mdid)
 				   mdid->GetBuffer());
 	}
 
-	CWStringDynamic *func_name_str =
-		CDXLUtils::CreateDynamicStringFromCharArray(mp, name);
-	CMDName *mdname = GPOS_NEW(mp) CMDName(mp, func_name_str);
-
-	// CMDName ctor created a copy of the string
-	GPOS_DELETE(func_name_str);
+	CMDName *mdname = CDXLUtils::CreateMDNameFromCharArray(mp, name);
 
 	// get result type
 	OID result_oid = gpdb::GetFuncRetType(func_oid);
@@ -1976,12 +1965,7 @@ CTranslatorRelcacheToDXL::RetrieveAgg(CMemoryPool *mp, IMDId *mdid)
 				   mdid->GetBuffer());
 	}
 
-	CWStringDynamic *agg_name_str =
-		CDXLUtils::CreateDynamicStringFromCharArray(mp, name);
-	CMDName *mdname = GPOS_NEW(mp) CMDName(mp, agg_name_str);
-
-	// CMDName ctor created a copy of the string
-	GPOS_DELETE(agg_name_str);
+	CMDName *mdname = CDXLUtils::CreateMDNameFromCharArray(mp, name);
 
 	// get result type
 	OID result_oid = gpdb::GetFuncRetType(agg_oid);
@@ -2036,10 +2020,7 @@ CTranslatorRelcacheToDXL::RetrieveTrigger(CMemoryPool *mp, IMDId *mdid)
 				   mdid->GetBuffer());
 	}
 
-	CWStringDynamic *trigger_name_str =
-		CDXLUtils::CreateDynamicStringFromCharArray(mp, name);
-	CMDName *mdname = GPOS_NEW(mp) CMDName(mp, trigger_name_str);
-	GPOS_DELETE(trigger_name_str);
+	CMDName *mdname = CDXLUtils::CreateMDNameFromCharArray(mp, name);
 
 	// get relation oid
 	OID rel_oid = gpdb::GetTriggerRelid(trigger_oid);
@@ -2087,10 +2068,7 @@ CTranslatorRelcacheToDXL::RetrieveCheckConstraints(CMemoryPool *mp,
 		GPOS_RAISE(gpdxl::ExmaMD, gpdxl::ExmiMDCacheEntryNotFound,
 				   mdid->GetBuffer());
 	}
-	CWStringDynamic *check_constr_name =
-		CDXLUtils::CreateDynamicStringFromCharArray(mp, name);
-	CMDName *mdname = GPOS_NEW(mp) CMDName(mp, check_constr_name);
-	GPOS_DELETE(check_constr_name);
+	CMDName *mdname = CDXLUtils::CreateMDNameFromCharArray(mp, name);
 
 	// get relation oid associated with the check constraint
 	OID rel_oid = gpdb::GetCheckConstraintRelid(check_constraint_oid);
@@ -2157,12 +2135,7 @@ CTranslatorRelcacheToDXL::GetTypeName(CMemoryPool *mp, IMDId *mdid)
 	CHAR *typename_str = gpdb::GetTypeName(oid_type);
 	GPOS_ASSERT(NULL != typename_str);
 
-	CWStringDynamic *str_name =
-		CDXLUtils::CreateDynamicStringFromCharArray(mp, typename_str);
-	CMDName *mdname = GPOS_NEW(mp) CMDName(mp, str_name);
-
-	// cleanup
-	GPOS_DELETE(str_name);
+	CMDName *mdname = CDXLUtils::CreateMDNameFromCharArray(mp, typename_str);
 	return mdname;
 }
 
@@ -2296,11 +2269,7 @@ CTranslatorRelcacheToDXL::RetrieveRelStats(CMemoryPool *mp, IMDId *mdid)
 	{
 		// get rel name
 		CHAR *relname = NameStr(rel->rd_rel->relname);
-		CWStringDynamic *relname_str =
-			CDXLUtils::CreateDynamicStringFromCharArray(mp, relname);
-		mdname = GPOS_NEW(mp) CMDName(mp, relname_str);
-		// CMDName ctor created a copy of the string
-		GPOS_DELETE(relname_str);
+		mdname = CDXLUtils::CreateMDNameFromCharArray(mp, relname);
 
 		num_rows = gpdb::CdbEstimatePartitionedNumTuples(rel);
 
@@ -3411,12 +3380,23 @@ CTranslatorRelcacheToDXL::RetrievePartConstraintForRel(
 {
 	// get the part constraints
 	List *default_levels_rel = NIL;
-	Node *node;
+	Node *node = NULL;
 
 	if (!GPOS_FTRACE(EopttraceEnableExternalPartitionedTables) ||
 		gpdb::RelPartIsRoot(rel_oid))
 	{
-		node = gpdb::GetRelationPartContraints(rel_oid, &default_levels_rel);
+		if (construct_full_expr)
+		{
+			node =
+				gpdb::GetRelationPartContraints(rel_oid, &default_levels_rel);
+		}
+		else
+		{
+			// the constraint expression is not needed; building it looks up
+			// the constraints of every part, which is slow for tables with
+			// many partitions, so only find the levels with default parts
+			default_levels_rel = gpdb::GetRelationPartDefaultLevels(rel_oid);
+		}
 	}
 	else if (gpdb::IsLeafPartition(rel_oid))
 	{
@@ -490,11 +490,8 @@ CTranslatorUtils::GetColumnDescriptorsFromRecord(CMemoryPool *mp,
 		INT type_modifier = lfirst_int(col_type_modifier);
 
 		CHAR *col_name_char_array = strVal(value);
-		CWStringDynamic *column_name =
-			CDXLUtils::CreateDynamicStringFromCharArray(mp,
-														col_name_char_array);
-		CMDName *col_mdname = GPOS_NEW(mp) CMDName(mp, column_name);
-		GPOS_DELETE(column_name);
+		CMDName *col_mdname =
+			CDXLUtils::CreateMDNameFromCharArray(mp, col_name_char_array);
 
 		IMDId *col_type = GPOS_NEW(mp) CMDIdGPDB(IMDId::EmdidGeneral, coltype);
 
@@ -534,11 +531,8 @@ CTranslatorUtils::GetColumnDescriptorsFromRecord(CMemoryPool *mp,
 		Value *value = (Value *) lfirst(col_name);
 
 		CHAR *col_name_char_array = strVal(value);
-		CWStringDynamic *column_name =
-			CDXLUtils::CreateDynamicStringFromCharArray(mp,
-														col_name_char_array);
-		CMDName *col_mdname = GPOS_NEW(mp) CMDName(mp, column_name);
-		GPOS_DELETE(column_name);
+		CMDName *col_mdname =
+			CDXLUtils::CreateMDNameFromCharArray(mp, col_name_char_array);
 
 		IMDId *col_type = (*out_arg_types)[ul];
 		col_type->AddRef();
@@ -1544,11 +1538,8 @@ CTranslatorUtils::GetColumnDescrAt(CMemoryPool *mp, TargetEntry *target_entry,
 	}
 	else
 	{
-		CWStringDynamic *alias = CDXLUtils::CreateDynamicStringFromCharArray(
-			mp, target_entry->resname);
-		mdname = GPOS_NEW(mp) CMDName(mp, alias);
-		// CName constructor copies string
-		GPOS_DELETE(alias);
+		mdname =
+			CDXLUtils::CreateMDNameFromCharArray(mp, target_entry->resname);
 	}
 
 	// create a column descriptor
@@ -1993,7 +1984,22 @@ CTranslatorUtils::CreateMultiByteCharStringFromWCString(const WCHAR *wcstr)
 {
 	GPOS_ASSERT(NULL != wcstr);
 
-	ULONG max_len = GPOS_WSZ_LENGTH(wcstr) * GPOS_SIZEOF(WCHAR) + 1;
+	ULONG len = 0;
+	if (CDXLUtils::IsASCII(wcstr, &len))
+	{
+		// names are mostly plain ASCII: copy them into an exactly sized
+		// buffer instead of going through the locale-aware conversion
+		CHAR *str = (CHAR *) gpdb::GPDBAlloc(len + 1);
+		for (ULONG ul = 0; ul < len; ul++)
+		{
+			str[ul] = (CHAR) wcstr[ul];
+		}
+		str[len] = '\0';
+
+		return str;
+	}
+
+	ULONG max_len = len * GPOS_SIZEOF(WCHAR) + 1;
 	CHAR *str = (CHAR *) gpdb::GPDBAlloc(max_len);
 #ifdef GPOS_DEBUG
 	LINT li = (INT)
@@ -2175,10 +2181,7 @@ CTranslatorUtils::CreateDXLProjElemConstNULL(CMemoryPool *mp,
 	}
 	else
 	{
-		CWStringDynamic *alias =
-			CDXLUtils::CreateDynamicStringFromCharArray(mp, alias_name);
-		alias_mdname = GPOS_NEW(mp) CMDName(mp, alias);
-		GPOS_DELETE(alias);
+		alias_mdname = CDXLUtils::CreateMDNameFromCharArray(mp, alias_name);
 	}
 
 	mdid->AddRef();
@@ -0,0 +1,195 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2019 Pivotal, Inc.
+//
+//	@filename:
+//		CMemoryPoolArena.cpp
+//
+//	@doc:
+//		CMemoryPool implementation that carves allocations out of large
+//		blocks taken from a PostgreSQL memory context.
+//
+//---------------------------------------------------------------------------
+
+extern "C" {
+#include "postgres.h"
+
+#include "utils/memutils.h"
+}
+
+#include "gpos/common/clibwrapper.h"
+#include "gpos/memory/CMemoryPool.h"
+
+#include "gpopt/gpdbwrappers.h"
+#include "gpopt/utils/CMemoryPoolArena.h"
+
+using namespace gpos;
+
+// ctor
+CMemoryPoolArena::CMemoryPoolArena()
+	: m_cxt(NULL),
+	  m_blocks(NULL),
+	  m_free_ptr(NULL),
+	  m_end_ptr(NULL),
+	  m_next_block_size(GPOPT_ARENA_MIN_BLOCK_SIZE),
+	  m_num_allocations(0),
+	  m_user_allocated_size(0)
+{
+	for (ULONG ul = 0; ul < GPOPT_ARENA_NUM_SIZE_CLASSES; ul++)
+	{
+		m_free_lists[ul] = NULL;
+	}
+
+	m_cxt = gpdb::GPDBAllocSetContextCreate();
+}
+
+// start a new arena block big enough for the given chunk; whatever is left
+// in the current block is abandoned
+void
+CMemoryPoolArena::NewBlock(ULONG chunk_size)
+{
+	ULONG block_size = m_next_block_size;
+	ULONG min_size = GPOS_MEM_ALIGNED_STRUCT_SIZE(SArenaBlock) + chunk_size;
+
+	while (block_size < min_size)
+	{
+		block_size *= 2;
+	}
+
+	SArenaBlock *block = static_cast<SArenaBlock *>(
+		gpdb::GPDBMemoryContextAlloc(m_cxt, block_size));
+
+	block->m_mp = this;
+	block->m_next = m_blocks;
+	m_blocks = block;
+
+	m_free_ptr = reinterpret_cast<BYTE *>(block) +
+				 GPOS_MEM_ALIGNED_STRUCT_SIZE(SArenaBlock);
+	m_end_ptr = reinterpret_cast<BYTE *>(block) + block_size;
+
+	// grow the blocks geometrically, so that small pools stay small and
+	// large ones need few calls into the memory context
+	if (m_next_block_size < GPOPT_ARENA_MAX_BLOCK_SIZE)
+	{
+		m_next_block_size *= 2;
+	}
+}
+
+void *
+CMemoryPoolArena::NewImpl(const ULONG bytes, const CHAR *, const ULONG,
+						  CMemoryPool::EAllocationType)
+{
+	SAllocHeader *header;
+
+	m_num_allocations++;
+	m_user_allocated_size += bytes;
+
+	// large allocations bypass the arena
+	if (bytes > GPOPT_ARENA_MAX_CHUNK_SIZE)
+	{
+		header = static_cast<SAllocHeader *>(gpdb::GPDBMemoryContextAlloc(
+			m_cxt, GPOS_MEM_ALIGNED_STRUCT_SIZE(SAllocHeader) +
+					   GPOS_MEM_ALIGNED_SIZE(bytes)));
+		header->m_user_size = bytes;
+		header->m_block_offset = 0;
+
+		return reinterpret_cast<BYTE *>(header) +
+			   GPOS_MEM_ALIGNED_STRUCT_SIZE(SAllocHeader);
+	}
+
+	// reuse a released allocation of the same size class, if any
+	ULONG size_class = SizeClass(bytes);
+	SFreeChunk *chunk = m_free_lists[size_class];
+	if (NULL != chunk)
+	{
+		m_free_lists[size_class] = chunk->m_next;
+
+		header = reinterpret_cast<SAllocHeader *>(
+			reinterpret_cast<BYTE *>(chunk) -
+			GPOS_MEM_ALIGNED_STRUCT_SIZE(SAllocHeader));
+		header->m_user_size = bytes;
+
+		return chunk;
+	}
+
+	// otherwise bump the pointer of the current block; every chunk must be
+	// able to hold a free list link once it is released
+	ULONG chunk_size = GPOS_MEM_ALIGNED_STRUCT_SIZE(SAllocHeader) +
+					   (size_class + 1) * GPOS_MEM_ARCH;
+	if (m_free_ptr + chunk_size > m_end_ptr)
+	{
+		NewBlock(chunk_size);
+	}
+
+	header = reinterpret_cast<SAllocHeader *>(m_free_ptr);
+	header->m_user_size = bytes;
+	header->m_block_offset =
+		(ULONG)(m_free_ptr - reinterpret_cast<BYTE *>(m_blocks));
+	m_free_ptr += chunk_size;
+
+	return reinterpret_cast<BYTE *>(header) +
+		   GPOS_MEM_ALIGNED_STRUCT_SIZE(SAllocHeader);
+}
+
+// put an arena allocation on its free list
+void
+CMemoryPoolArena::Release(SAllocHeader *header)
+{
+	ULONG size_class = SizeClass(header->m_user_size);
+	SFreeChunk *chunk = reinterpret_cast<SFreeChunk *>(
+		reinterpret_cast<BYTE *>(header) +
+		GPOS_MEM_ALIGNED_STRUCT_SIZE(SAllocHeader));
+
+#ifdef GPOS_DEBUG
+	clib::Memset(chunk, GPOS_MEM_FREED_PATTERN_CHAR,
+				 (size_class + 1) * GPOS_MEM_ARCH);
+#endif	// GPOS_DEBUG
+
+	chunk->m_next = m_free_lists[size_class];
+	m_free_lists[size_class] = chunk;
+}
+
+void
+CMemoryPoolArena::DeleteImpl(void *ptr, CMemoryPool::EAllocationType)
+{
+	SAllocHeader *header = reinterpret_cast<SAllocHeader *>(
+		static_cast<BYTE *>(ptr) - GPOS_MEM_ALIGNED_STRUCT_SIZE(SAllocHeader));
+
+	if (0 == header->m_block_offset)
+	{
+		gpdb::GPDBFree(header);
+		return;
+	}
+
+	SArenaBlock *block = reinterpret_cast<SArenaBlock *>(
+		reinterpret_cast<BYTE *>(header) - header->m_block_offset);
+	block->m_mp->Release(header);
+}
+
+// Prepare the memory pool to be deleted; this releases all arena blocks
+void
+CMemoryPoolArena::TearDown()
+{
+	gpdb::GPDBMemoryContextDelete(m_cxt);
+}
+
+// Total allocated size including management overheads
+ULLONG
+CMemoryPoolArena::TotalAllocatedSize() const
+{
+	return MemoryContextGetCurrentSpace(m_cxt);
+}
+
+// get user requested size of allocation
+ULONG
+CMemoryPoolArena::UserSizeOfAlloc(const void *ptr)
+{
+	GPOS_ASSERT(ptr != NULL);
+	const SAllocHeader *header = reinterpret_cast<const SAllocHeader *>(
+		static_cast<const BYTE *>(ptr) -
+		GPOS_MEM_ALIGNED_STRUCT_SIZE(SAllocHeader));
+	return header->m_user_size;
+}
+
+
+// EOF
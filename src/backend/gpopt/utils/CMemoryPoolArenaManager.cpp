@@ -0,0 +1,60 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2019 Pivotal, Inc.
+//
+//	@filename:
+//		CMemoryPoolArenaManager.cpp
+//
+//	@doc:
+//		MemoryPoolManager implementation that creates
+//		CMemoryPoolArena memory pools
+//
+//---------------------------------------------------------------------------
+
+extern "C" {
+#include "postgres.h"
+
+#include "utils/memutils.h"
+}
+
+#include "gpopt/utils/CMemoryPoolArena.h"
+#include "gpopt/utils/CMemoryPoolArenaManager.h"
+
+using namespace gpos;
+
+// ctor
+CMemoryPoolArenaManager::CMemoryPoolArenaManager(CMemoryPool *internal,
+												 EMemoryPoolType)
+	: CMemoryPoolManager(internal, EMemoryPoolExternal)
+{
+}
+
+// create new memory pool
+CMemoryPool *
+CMemoryPoolArenaManager::NewMemoryPool()
+{
+	return GPOS_NEW(GetInternalMemoryPool()) CMemoryPoolArena();
+}
+
+void
+CMemoryPoolArenaManager::DeleteImpl(void *ptr,
+									CMemoryPool::EAllocationType eat)
+{
+	CMemoryPoolArena::DeleteImpl(ptr, eat);
+}
+
+// get user requested size of allocation
+ULONG
+CMemoryPoolArenaManager::UserSizeOfAlloc(const void *ptr)
+{
+	return CMemoryPoolArena::UserSizeOfAlloc(ptr);
+}
+
+void
+CMemoryPoolArenaManager::Init()
+{
+	CMemoryPoolManager::SetupGlobalMemoryPoolManager<CMemoryPoolArenaManager,
+													 CMemoryPoolArena>();
+}
+
+// EOF
@@ -12,6 +12,7 @@
 #define GPOPT_CEngine_H
 
 #include "gpos/base.h"
+#include "gpos/common/CWallClock.h"
 
 #include "gpopt/search/CMemo.h"
 #include "gpopt/search/CSearchStage.h"
@@ -57,6 +58,27 @@ private:
 	// index of current search stage
 	ULONG m_ulCurrSearchStage;
 
+	// wall clock started when optimization starts, used to enforce the
+	// search time budget
+	CWallClock m_search_timer;
+
+	// search time budget in ms and memory budget in bytes, 0 if unlimited
+	ULONG m_ulSearchTimeBudget;
+	ULLONG m_ullSearchMemoryBudget;
+
+	// set once the search budget is exhausted
+	BOOL m_fBudgetExhausted;
+
+	// is the current stage the one added to complete a plan after the
+	// budget was exhausted
+	BOOL m_fRescueStage;
+
+	// allocated bytes at which the rescue stage stops, 0 if unlimited
+	ULLONG m_ullRescueMemoryLimit;
+
+	// set once the rescue stage used up its memory budget
+	BOOL m_fRescueBudgetExhausted;
+
 	// memo table
 	CMemo *m_pmemo;
 
@@ -159,10 +181,28 @@ private:
 	BOOL
 	FSearchTerminated() const
 	{
-		// at least one stage has completed and achieved required cost
-		return (NULL != PssPrevious() && PssPrevious()->FAchievedReqdCost());
+		// at least one stage has completed and achieved required cost, or
+		// the search budget is exhausted
+		return (NULL != PssPrevious() && PssPrevious()->FAchievedReqdCost()) ||
+			   m_fBudgetExhausted;
 	}
 
+	// allocate xform statistics for one more search stage
+	void AddXformStats();
+
+	// check if time or memory budget of the search is exhausted
+	BOOL FBudgetExhausted();
+
+	// check if the rescue stage used up its share of the memory budget
+	BOOL FRescueBudgetExhausted();
+
+	// add a stage that completes a plan after the search budget was
+	// exhausted before any plan was found
+	void AddRescueSearchStage();
+
+	// optimize the root group in the current search stage
+	void OptimizeSearchStage(CSchedulerContext *psc);
+
 	// generate random plan id
 	ULLONG UllRandomPlanId(ULONG *seed);
 
@@ -327,6 +367,20 @@ public:
 		return (*m_search_stage_array)[m_ulCurrSearchStage];
 	}
 
+	// check if the current search stage must stop, either because it timed
+	// out or because the search budget, or the rescue stage's share of it,
+	// is exhausted
+	BOOL
+	FSearchInterrupted()
+	{
+		if (PssCurrent()->FTimedOut())
+		{
+			return true;
+		}
+
+		return m_fRescueStage ? FRescueBudgetExhausted() : FBudgetExhausted();
+	}
+
 	// current search stage index accessor
 	ULONG
 	UlCurrSearchStage() const
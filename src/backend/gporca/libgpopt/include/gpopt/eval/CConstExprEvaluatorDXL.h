@@ -19,8 +19,10 @@
 #define GPOPT_CConstExprEvaluatorDXL_H
 
 #include "gpos/base.h"
+#include "gpos/common/CHashMap.h"
 
 #include "gpopt/base/CColRef.h"
+#include "gpopt/base/CUtils.h"
 #include "gpopt/eval/IConstExprEvaluator.h"
 #include "gpopt/translate/CTranslatorDXLToExpr.h"
 #include "gpopt/translate/CTranslatorExprToDXL.h"
@@ -50,6 +52,15 @@ class IConstDXLNodeEvaluator;
 class CConstExprEvaluatorDXL : public IConstExprEvaluator
 {
 private:
+	// map of evaluated expressions to their results
+	typedef CHashMap<CExpression, CExpression, CExpression::HashValue,
+					 CUtils::Equals, CleanupRelease<CExpression>,
+					 CleanupRelease<CExpression> >
+		ExprToResultMap;
+
+	// memory pool
+	CMemoryPool *m_mp;
+
 	// evaluates expressions represented as DXL, not owned
 	IConstDXLNodeEvaluator *m_pconstdxleval;
 
@@ -59,6 +70,11 @@ private:
 	// translates DXL coming from the evaluator back to CExpression
 	CTranslatorDXLToExpr m_trdxl2expr;
 
+	// results of the expressions evaluated so far; the same comparisons
+	// between constants are evaluated over and over when deriving
+	// constraints, e.g. once for each partition of a table
+	ExprToResultMap *m_phmexprResults;
+
 	// private copy ctor
 	CConstExprEvaluatorDXL(const CConstExprEvaluatorDXL &);
 
@@ -143,8 +143,9 @@ public:
 		TEnumState estNext = estSentinel;
 		do
 		{
-			// check if current search stage is timed-out
-			if (psc->Peng()->PssCurrent()->FTimedOut())
+			// check if current search stage is timed-out or the search
+			// budget is exhausted
+			if (psc->Peng()->FSearchInterrupted())
 			{
 				// cleanup job state and terminate state machine
 				pjOwner->Cleanup();
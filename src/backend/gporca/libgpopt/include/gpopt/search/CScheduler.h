@@ -32,7 +32,7 @@ class CSchedulerContext;
 //		CScheduler
 //
 //	@doc:
-//		MT-scheduler for optimization jobs
+//		Scheduler for optimization jobs
 //
 //		Maintaining job dependencies and controlling the order of job execution
 //		are the main responsibilities of job scheduler.
@@ -51,6 +51,23 @@ class CSchedulerContext;
 //		complete. At this point, a queued job can be terminated if it does not
 //		have any further dependencies.
 //
+//		All jobs run on the worker of the optimizing backend (see
+//		CWorkerPoolManager).  The job model itself would allow independent
+//		jobs to run concurrently, but the search is not safe to run on other
+//		threads inside a GPDB backend:
+//		- memory pools allocate through palloc (CMemoryPoolPalloc) from
+//		  memory contexts that have no locking, so two threads allocating
+//		  at once corrupt the context;
+//		- the memo keeps its groups in a CSyncList and its group expressions
+//		  in a CSyncHashtable, and a group is modified through a CGroupProxy;
+//		  none of these lock anymore, so concurrent inserts into the memo or
+//		  into a group race;
+//		- metadata is fetched lazily while the search runs, and CMDAccessor
+//		  reaches the catalog caches and elog through the gpdb wrappers,
+//		  which may only be called from the backend's main thread.
+//		Running jobs on more than one worker requires locking in the memo
+//		and the memory pools, and metadata fetched before the search.
+//
 //---------------------------------------------------------------------------
 class CScheduler
 {
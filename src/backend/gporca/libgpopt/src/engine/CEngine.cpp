@@ -57,6 +57,8 @@
 #define GPOPT_JOBS_CAP 5000	 // maximum number of initial optimization jobs
 #define GPOPT_JOBS_PER_GROUP \
 	20	// estimated number of needed optimization jobs per memo group
+#define GPOPT_RESCUE_BUDGET_DIVISOR \
+	2  // the rescue stage may use this fraction of each search budget
 
 // memory consumption unit in bytes -- currently MB
 #define GPOPT_MEM_UNIT (1024 * 1024)
@@ -79,6 +81,12 @@ CEngine::CEngine(CMemoryPool *mp)
 	  m_pqc(NULL),
 	  m_search_stage_array(NULL),
 	  m_ulCurrSearchStage(0),
+	  m_ulSearchTimeBudget(0),
+	  m_ullSearchMemoryBudget(0),
+	  m_fBudgetExhausted(false),
+	  m_fRescueStage(false),
+	  m_ullRescueMemoryLimit(0),
+	  m_fRescueBudgetExhausted(false),
 	  m_pmemo(NULL),
 	  m_pexprEnforcerPattern(NULL),
 	  m_xforms(NULL),
@@ -175,28 +183,14 @@ CEngine::Init(CQueryContext *pqc, CSearchStageArray *search_stage_array)
 		const ULONG ulStages = m_search_stage_array->Size();
 		for (ULONG ul = 0; ul < ulStages; ul++)
 		{
-			ULONG_PTR *pulpXformCalls =
-				GPOS_NEW_ARRAY(m_mp, ULONG_PTR, CXform::ExfSentinel);
-			ULONG_PTR *pulpXformTimes =
-				GPOS_NEW_ARRAY(m_mp, ULONG_PTR, CXform::ExfSentinel);
-			ULONG_PTR *pulpXformBindings =
-				GPOS_NEW_ARRAY(m_mp, ULONG_PTR, CXform::ExfSentinel);
-			ULONG_PTR *pulpXformResults =
-				GPOS_NEW_ARRAY(m_mp, ULONG_PTR, CXform::ExfSentinel);
-			for (ULONG ulXform = 0; ulXform < CXform::ExfSentinel; ulXform++)
-			{
-				pulpXformCalls[ulXform] = 0;
-				pulpXformTimes[ulXform] = 0;
-				pulpXformBindings[ulXform] = 0;
-				pulpXformResults[ulXform] = 0;
-			}
-			m_pdrgpulpXformCalls->Append(pulpXformCalls);
-			m_pdrgpulpXformTimes->Append(pulpXformTimes);
-			m_pdrgpulpXformBindings->Append(pulpXformBindings);
-			m_pdrgpulpXformResults->Append(pulpXformResults);
+			AddXformStats();
 		}
 	}
 
+	CHint *phint = COptCtxt::PoctxtFromTLS()->GetOptimizerConfig()->GetHint();
+	m_ulSearchTimeBudget = phint->UlSearchTimeBudget();
+	m_ullSearchMemoryBudget = (ULLONG) phint->UlSearchMemoryBudget() * 1024;
+
 	m_pqc = pqc;
 	InitLogicalExpression(m_pqc->Pexpr());
 
@@ -205,6 +199,39 @@ CEngine::Init(CQueryContext *pqc, CSearchStageArray *search_stage_array)
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CEngine::AddXformStats
+//
+//	@doc:
+//		Allocate xform statistics for one more search stage
+//
+//---------------------------------------------------------------------------
+void
+CEngine::AddXformStats()
+{
+	ULONG_PTR *pulpXformCalls =
+		GPOS_NEW_ARRAY(m_mp, ULONG_PTR, CXform::ExfSentinel);
+	ULONG_PTR *pulpXformTimes =
+		GPOS_NEW_ARRAY(m_mp, ULONG_PTR, CXform::ExfSentinel);
+	ULONG_PTR *pulpXformBindings =
+		GPOS_NEW_ARRAY(m_mp, ULONG_PTR, CXform::ExfSentinel);
+	ULONG_PTR *pulpXformResults =
+		GPOS_NEW_ARRAY(m_mp, ULONG_PTR, CXform::ExfSentinel);
+	for (ULONG ulXform = 0; ulXform < CXform::ExfSentinel; ulXform++)
+	{
+		pulpXformCalls[ulXform] = 0;
+		pulpXformTimes[ulXform] = 0;
+		pulpXformBindings[ulXform] = 0;
+		pulpXformResults[ulXform] = 0;
+	}
+	m_pdrgpulpXformCalls->Append(pulpXformCalls);
+	m_pdrgpulpXformTimes->Append(pulpXformTimes);
+	m_pdrgpulpXformBindings->Append(pulpXformBindings);
+	m_pdrgpulpXformResults->Append(pulpXformResults);
+}
+
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CEngine::AddEnforcers
@@ -733,7 +760,7 @@ CEngine::ApplyTransformations(CMemoryPool *pmpLocal, CXformSet *xform_set,
 						  ulElapsedTime, ulNumberOfBindings);
 		pxfres->Release();
 
-		if (PssCurrent()->FTimedOut())
+		if (FSearchInterrupted())
 		{
 			break;
 		}
@@ -757,7 +784,7 @@ CEngine::TransitionGroupExpression(CMemoryPool *pmpLocal,
 	GPOS_ASSERT(CGroupExpression::estExplored == estTarget ||
 				CGroupExpression::estImplemented == estTarget);
 
-	if (PssCurrent()->FTimedOut())
+	if (FSearchInterrupted())
 	{
 		return;
 	}
@@ -817,7 +844,7 @@ CEngine::TransitionGroup(CMemoryPool *pmpLocal, CGroup *pgroup,
 	// check stack size
 	GPOS_CHECK_STACK_SIZE;
 
-	if (PssCurrent()->FTimedOut())
+	if (FSearchInterrupted())
 	{
 		return;
 	}
@@ -865,7 +892,7 @@ CEngine::TransitionGroup(CMemoryPool *pmpLocal, CGroup *pgroup,
 										  estGExprTargetState);
 			}
 
-			if (PssCurrent()->FTimedOut())
+			if (FSearchInterrupted())
 			{
 				break;
 			}
@@ -982,7 +1009,7 @@ CEngine::PccOptimizeChild(
 	CGroupExpression *pgexprChildBest =
 		PgexprOptimize(pgroupChild, pocChild, pgexpr);
 	pocChild->Release();
-	if (NULL == pgexprChildBest || PssCurrent()->FTimedOut())
+	if (NULL == pgexprChildBest || FSearchInterrupted())
 	{
 		// failed to generate a plan for the child, or search stage is timed-out
 		return NULL;
@@ -1209,7 +1236,7 @@ CEngine::PgexprOptimize(CGroup *pgroup, COptimizationContext *poc,
 				OptimizeGroupExpression(pgexprCurrent, poc);
 			}
 
-			if (PssCurrent()->FTimedOut())
+			if (FSearchInterrupted())
 			{
 				break;
 			}
@@ -1250,7 +1277,10 @@ CEngine::Explore()
 	GPOS_ASSERT(!PgroupRoot()->FExplored());
 
 	TransitionGroup(m_mp, PgroupRoot(), CGroup::estExplored /*estTarget*/);
-	GPOS_ASSERT_IMP(!PssCurrent()->FTimedOut(), PgroupRoot()->FExplored());
+
+	// checking the budget may mark it exhausted, so do it in all builds
+	BOOL fInterrupted GPOS_ASSERTS_ONLY = FSearchInterrupted();
+	GPOS_ASSERT_IMP(!fInterrupted, PgroupRoot()->FExplored());
 }
 
 
@@ -1272,7 +1302,10 @@ CEngine::Implement()
 	GPOS_ASSERT(!PgroupRoot()->FImplemented());
 
 	TransitionGroup(m_mp, PgroupRoot(), CGroup::estImplemented /*estTarget*/);
-	GPOS_ASSERT_IMP(!PssCurrent()->FTimedOut(), PgroupRoot()->FImplemented());
+
+	// checking the budget may mark it exhausted, so do it in all builds
+	BOOL fInterrupted GPOS_ASSERTS_ONLY = FSearchInterrupted();
+	GPOS_ASSERT_IMP(!fInterrupted, PgroupRoot()->FImplemented());
 }
 
 
@@ -1447,6 +1480,9 @@ CEngine::ScheduleMainJob(CSchedulerContext *psc, COptimizationContext *poc)
 void
 CEngine::FinalizeExploration()
 {
+	// time since the start of the stage, before stats derivation
+	const ULONG ulExplorationTime = PssCurrent()->UlElapsedTime();
+
 	GroupMerge();
 
 	if (m_pqc->FDeriveStats())
@@ -1479,6 +1515,9 @@ CEngine::FinalizeExploration()
 	if (GPOS_FTRACE(EopttracePrintOptimizationStatistics))
 	{
 		CAutoTrace at(m_mp);
+		at.Os() << std::endl
+				<< "[OPT]: Exploration (stage " << m_ulCurrSearchStage
+				<< ") completed in " << ulExplorationTime << " msec";
 		(void) OsPrintMemoryConsumption(
 			at.Os(), "Memory consumption after exploration ");
 	}
@@ -1496,6 +1535,9 @@ CEngine::FinalizeExploration()
 void
 CEngine::FinalizeImplementation()
 {
+	// time since the start of the stage
+	const ULONG ulImplementationTime = PssCurrent()->UlElapsedTime();
+
 	if (GPOS_FTRACE(EopttracePrintMemoAfterImplementation))
 	{
 		{
@@ -1513,6 +1555,9 @@ CEngine::FinalizeImplementation()
 	if (GPOS_FTRACE(EopttracePrintOptimizationStatistics))
 	{
 		CAutoTrace at(m_mp);
+		at.Os() << std::endl
+				<< "[OPT]: Implementation (stage " << m_ulCurrSearchStage
+				<< ") completed in " << ulImplementationTime << " msec";
 		(void) OsPrintMemoryConsumption(
 			at.Os(), "Memory consumption after implementation ");
 	}
@@ -1596,6 +1641,9 @@ CEngine::OsPrintMemoryConsumption(IOstream &os, const CHAR *szHeader) const
 	os << std::endl
 	   << szHeader << "Engine: ["
 	   << (DOUBLE) m_mp->TotalAllocatedSize() / GPOPT_MEM_UNIT << "] "
+	   << GPOPT_MEM_UNIT_NAME << " in [" << m_mp->NumAllocations()
+	   << "] allocations of ["
+	   << (DOUBLE) m_mp->UserAllocatedSize() / GPOPT_MEM_UNIT << "] "
 	   << GPOPT_MEM_UNIT_NAME << ", MD Cache: ["
 	   << (DOUBLE)(pcache->TotalAllocatedSize()) / GPOPT_MEM_UNIT << "] "
 	   << GPOPT_MEM_UNIT_NAME << ", Total: ["
@@ -1695,36 +1743,32 @@ CEngine::Optimize()
 	CSchedulerContext sc;
 	sc.Init(m_mp, &jf, &sched, this);
 
+	m_search_timer.Restart();
+
 	const ULONG ulSearchStages = m_search_stage_array->Size();
 	for (ULONG ul = 0; !FSearchTerminated() && ul < ulSearchStages; ul++)
 	{
-		PssCurrent()->RestartTimer();
-
-		// optimize root group
-		m_pqc->Prpp()->AddRef();
-		COptimizationContext *poc = GPOS_NEW(m_mp) COptimizationContext(
-			m_mp, PgroupRoot(), m_pqc->Prpp(),
-			GPOS_NEW(m_mp) CReqdPropRelational(GPOS_NEW(m_mp) CColRefSet(
-				m_mp)),	 // pass empty required relational properties initially
-			GPOS_NEW(m_mp)
-				IStatisticsArray(m_mp),	 // pass empty stats context initially
-			m_ulCurrSearchStage);
-
-		// schedule main optimization job
-		ScheduleMainJob(&sc, poc);
-
-		// run optimization job
-		CScheduler::Run(&sc);
-
-		poc->Release();
+		OptimizeSearchStage(&sc);
+	}
 
-		// extract best plan found at the end of current search stage
-		CExpression *pexprPlan = m_pmemo->PexprExtractPlan(
-			m_mp, m_pmemo->PgroupRoot(), m_pqc->Prpp(),
-			m_search_stage_array->Size());
-		PssCurrent()->SetBestExpr(pexprPlan);
+	if (m_fBudgetExhausted && NULL == PssPrevious()->PexprBest())
+	{
+		// the budget ran out before a complete plan was found, finish the
+		// search with a cheaper stage instead of failing optimization
+		AddRescueSearchStage();
+		OptimizeSearchStage(&sc);
 
-		FinalizeSearchStage();
+		if (NULL == PssPrevious()->PexprBest())
+		{
+			// the rescue stage ran out of its share of the budget as well,
+			// let the caller fall back to the Postgres planner
+			{
+				CAutoTrace at(m_mp);
+				at.Os() << "[OPT]: Rescue stage " << m_ulCurrSearchStage - 1
+						<< " found no plan within its budget";
+			}
+			GPOS_RAISE(gpopt::ExmaGPOPT, gpopt::ExmiNoPlanFound);
+		}
 	}
 
 
@@ -1744,6 +1788,183 @@ CEngine::Optimize()
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CEngine::OptimizeSearchStage
+//
+//	@doc:
+//		Optimize the root group in the current search stage
+//
+//---------------------------------------------------------------------------
+void
+CEngine::OptimizeSearchStage(CSchedulerContext *psc)
+{
+	PssCurrent()->RestartTimer();
+
+	// optimize root group
+	m_pqc->Prpp()->AddRef();
+	COptimizationContext *poc = GPOS_NEW(m_mp) COptimizationContext(
+		m_mp, PgroupRoot(), m_pqc->Prpp(),
+		GPOS_NEW(m_mp) CReqdPropRelational(GPOS_NEW(m_mp) CColRefSet(
+			m_mp)),	 // pass empty required relational properties initially
+		GPOS_NEW(m_mp)
+			IStatisticsArray(m_mp),	 // pass empty stats context initially
+		m_ulCurrSearchStage);
+
+	// schedule main optimization job
+	ScheduleMainJob(psc, poc);
+
+	// run optimization job
+	CScheduler::Run(psc);
+
+	poc->Release();
+
+	// extract best plan found at the end of current search stage
+	CExpression *pexprPlan =
+		m_pmemo->PexprExtractPlan(m_mp, m_pmemo->PgroupRoot(), m_pqc->Prpp(),
+								  m_search_stage_array->Size());
+	PssCurrent()->SetBestExpr(pexprPlan);
+
+	FinalizeSearchStage();
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CEngine::FBudgetExhausted
+//
+//	@doc:
+//		Check if the time or memory budget of the search is exhausted;
+//		once exhausted, the budget stays exhausted for the rest of the
+//		optimization
+//
+//---------------------------------------------------------------------------
+BOOL
+CEngine::FBudgetExhausted()
+{
+	if (m_fBudgetExhausted)
+	{
+		return true;
+	}
+
+	if (0 == m_ulSearchTimeBudget && 0 == m_ullSearchMemoryBudget)
+	{
+		return false;
+	}
+
+	const ULONG ulElapsed = m_search_timer.ElapsedMS();
+	const ULLONG ullAllocated = m_mp->TotalAllocatedSize();
+	if ((0 < m_ulSearchTimeBudget && ulElapsed > m_ulSearchTimeBudget) ||
+		(0 < m_ullSearchMemoryBudget && ullAllocated > m_ullSearchMemoryBudget))
+	{
+		m_fBudgetExhausted = true;
+
+		// always traced, as the plan may be worse than a full search's
+		CAutoTrace at(m_mp);
+		at.Os() << "[OPT]: Search budget exhausted in stage "
+				<< m_ulCurrSearchStage << " after " << ulElapsed
+				<< " msec and " << ullAllocated / 1024 << " KB";
+	}
+
+	return m_fBudgetExhausted;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CEngine::FRescueBudgetExhausted
+//
+//	@doc:
+//		Check if the rescue stage used up its share of the memory budget;
+//		its share of the time budget is enforced by the stage timeout
+//
+//---------------------------------------------------------------------------
+BOOL
+CEngine::FRescueBudgetExhausted()
+{
+	GPOS_ASSERT(m_fRescueStage);
+
+	if (m_fRescueBudgetExhausted || 0 == m_ullRescueMemoryLimit)
+	{
+		return m_fRescueBudgetExhausted;
+	}
+
+	const ULLONG ullAllocated = m_mp->TotalAllocatedSize();
+	if (ullAllocated > m_ullRescueMemoryLimit)
+	{
+		m_fRescueBudgetExhausted = true;
+
+		CAutoTrace at(m_mp);
+		at.Os() << "[OPT]: Rescue stage " << m_ulCurrSearchStage
+				<< " exhausted its memory budget at " << ullAllocated / 1024
+				<< " KB";
+	}
+
+	return m_fRescueBudgetExhausted;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CEngine::AddRescueSearchStage
+//
+//	@doc:
+//		Add a stage that completes a plan after the search budget was
+//		exhausted before any plan was found; the stage uses the xforms of
+//		the interrupted stage except the expensive join order xforms, and
+//		may use GPOPT_RESCUE_BUDGET_DIVISOR-th of the time and memory
+//		budgets on top of what was already spent
+//
+//---------------------------------------------------------------------------
+void
+CEngine::AddRescueSearchStage()
+{
+	GPOS_ASSERT(m_fBudgetExhausted);
+	GPOS_ASSERT(!m_fRescueStage);
+	GPOS_ASSERT(NULL != PssPrevious());
+
+	CXformSet *xform_set = GPOS_NEW(m_mp) CXformSet(m_mp);
+	xform_set->Union(PssPrevious()->GetXformSet());
+	(void) xform_set->ExchangeClear(CXform::ExfExpandNAryJoinDP);
+	(void) xform_set->ExchangeClear(CXform::ExfExpandNAryJoinDPv2);
+	(void) xform_set->ExchangeClear(CXform::ExfExpandNAryJoinMinCard);
+	(void) xform_set->ExchangeClear(CXform::ExfExpandNAryJoinGreedy);
+	(void) xform_set->ExchangeClear(CXform::ExfJoinAssociativity);
+	(void) xform_set->ExchangeClear(CXform::ExfJoinCommutativity);
+
+	// keep the join order of the query
+	(void) xform_set->ExchangeSet(CXform::ExfExpandNAryJoin);
+
+	ULONG ulTimeThreshold = gpos::ulong_max;
+	if (0 < m_ulSearchTimeBudget)
+	{
+		ulTimeThreshold =
+			std::max((ULONG) 1, m_ulSearchTimeBudget / GPOPT_RESCUE_BUDGET_DIVISOR);
+	}
+	if (0 < m_ullSearchMemoryBudget)
+	{
+		m_ullRescueMemoryLimit =
+			m_mp->TotalAllocatedSize() +
+			m_ullSearchMemoryBudget / GPOPT_RESCUE_BUDGET_DIVISOR;
+	}
+
+	m_search_stage_array->Append(GPOS_NEW(m_mp)
+									 CSearchStage(xform_set, ulTimeThreshold));
+	if (GPOS_FTRACE(EopttracePrintOptimizationStatistics))
+	{
+		AddXformStats();
+	}
+
+	// skip the stages that were not started
+	m_ulCurrSearchStage = m_search_stage_array->Size() - 1;
+	m_fRescueStage = true;
+
+	CAutoTrace at(m_mp);
+	at.Os() << "[OPT]: Completing the plan in rescue stage "
+			<< m_ulCurrSearchStage;
+}
+
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CEngine::CEngine
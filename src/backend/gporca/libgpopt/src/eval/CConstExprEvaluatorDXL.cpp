@@ -40,11 +40,14 @@ using namespace gpos;
 CConstExprEvaluatorDXL::CConstExprEvaluatorDXL(
 	CMemoryPool *mp, CMDAccessor *md_accessor,
 	IConstDXLNodeEvaluator *pconstdxleval)
-	: m_pconstdxleval(pconstdxleval),
+	: m_mp(mp),
+	  m_pconstdxleval(pconstdxleval),
 	  m_trexpr2dxl(mp, md_accessor, NULL /*pdrgpiSegments*/,
 				   false /*fInitColumnFactory*/),
-	  m_trdxl2expr(mp, md_accessor, false /*fInitColumnFactory*/)
+	  m_trdxl2expr(mp, md_accessor, false /*fInitColumnFactory*/),
+	  m_phmexprResults(NULL)
 {
+	m_phmexprResults = GPOS_NEW(m_mp) ExprToResultMap(m_mp);
 }
 
 //---------------------------------------------------------------------------
@@ -57,6 +60,7 @@ CConstExprEvaluatorDXL::CConstExprEvaluatorDXL(
 //---------------------------------------------------------------------------
 CConstExprEvaluatorDXL::~CConstExprEvaluatorDXL()
 {
+	m_phmexprResults->Release();
 }
 
 //---------------------------------------------------------------------------
@@ -65,7 +69,10 @@ CConstExprEvaluatorDXL::~CConstExprEvaluatorDXL()
 //
 //	@doc:
 //		Evaluate the given expression and return the result as a new expression.
-//		Caller takes ownership of returned expression
+//		Caller takes ownership of returned expression.
+//		Results are remembered for the lifetime of the evaluator, so that an
+//		expression that was evaluated before is neither translated nor sent
+//		to the DXL evaluator again.
 //
 //---------------------------------------------------------------------------
 CExpression *
@@ -77,14 +84,34 @@ CConstExprEvaluatorDXL::PexprEval(CExpression *pexpr)
 	{
 		GPOS_RAISE(gpopt::ExmaGPOPT, gpopt::ExmiEvalUnsupportedScalarExpr);
 	}
+
+	CExpression *pexprResult = m_phmexprResults->Find(pexpr);
+	if (NULL != pexprResult)
+	{
+		pexprResult->AddRef();
+		return pexprResult;
+	}
+
 	CDXLNode *pdxlnExpr = m_trexpr2dxl.PdxlnScalar(pexpr);
 	CDXLNode *pdxlnResult = m_pconstdxleval->EvaluateExpr(pdxlnExpr);
 
 	GPOS_ASSERT(EdxloptypeScalar ==
 				pdxlnResult->GetOperator()->GetDXLOperatorType());
 
-	CExpression *pexprResult =
+	pexprResult =
 		m_trdxl2expr.PexprTranslateScalar(pdxlnResult, NULL /*colref_array*/);
+
+	// the given expression is typically built in a short-lived memory pool,
+	// so key the result by a copy translated back from its DXL
+	CExpression *pexprKey =
+		m_trdxl2expr.PexprTranslateScalar(pdxlnExpr, NULL /*colref_array*/);
+	pexprResult->AddRef();
+	if (!m_phmexprResults->Insert(pexprKey, pexprResult))
+	{
+		pexprKey->Release();
+		pexprResult->Release();
+	}
+
 	pdxlnResult->Release();
 	pdxlnExpr->Release();
 
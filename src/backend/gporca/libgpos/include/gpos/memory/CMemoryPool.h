@@ -154,6 +154,20 @@ public:
 		return 0;
 	}
 
+	// return number of allocation requests served, if the pool counts them
+	virtual ULLONG
+	NumAllocations() const
+	{
+		return 0;
+	}
+
+	// return sum of user requested sizes, if the pool counts them
+	virtual ULLONG
+	UserAllocatedSize() const
+	{
+		return 0;
+	}
+
 	// requested size of allocation
 	static ULONG UserSizeOfAlloc(const void *ptr);
 
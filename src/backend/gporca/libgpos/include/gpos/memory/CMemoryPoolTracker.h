@@ -109,6 +109,13 @@ public:
 		return m_memory_pool_statistics.TotalAllocatedSize();
 	}
 
+	// return number of allocation requests served
+	virtual ULLONG
+	NumAllocations() const
+	{
+		return m_memory_pool_statistics.GetNumSuccessfulAllocations();
+	}
+
 #ifdef GPOS_DEBUG
 
 	// check if the memory pool keeps track of live objects
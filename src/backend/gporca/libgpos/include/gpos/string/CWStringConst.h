@@ -38,6 +38,9 @@ public:
 	CWStringConst(const WCHAR *w_str_buffer);
 	CWStringConst(CMemoryPool *mp, const WCHAR *w_str_buffer);
 
+	// ctor widening a 7-bit ASCII character array of given length
+	CWStringConst(CMemoryPool *mp, const CHAR *str, ULONG length);
+
 	// shallow copy ctor
 	CWStringConst(const CWStringConst &);
 
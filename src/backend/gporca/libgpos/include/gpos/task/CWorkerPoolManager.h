@@ -62,7 +62,9 @@ private:
 	// active flag
 	BOOL m_active;
 
-	// we only support a single worker now
+	// we only support a single worker now: the optimizer runs inside a
+	// backend, whose memory contexts and catalog access are single-threaded
+	// (see CScheduler)
 	CWorker *m_single_worker;
 
 	// task storage
@@ -70,6 +70,45 @@ CWStringConst::CWStringConst(CMemoryPool *mp, const WCHAR *w_str_buffer)
 	GPOS_ASSERT(IsValid());
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CWStringConst::CWStringConst
+//
+//	@doc:
+//		Initializes a constant string by widening the given 7-bit ASCII
+//		character array, which needs no locale-dependent conversion.
+//		The string owns the memory.
+//
+//---------------------------------------------------------------------------
+CWStringConst::CWStringConst(CMemoryPool *mp, const CHAR *str, ULONG length)
+	: CWStringBase(length,
+				   true	 // owns_memory
+				   ),
+	  m_w_str_buffer(NULL)
+{
+	GPOS_ASSERT(NULL != mp);
+	GPOS_ASSERT(NULL != str);
+
+	if (0 == m_length)
+	{
+		// string is empty
+		m_w_str_buffer = &m_empty_wcstr;
+	}
+	else
+	{
+		WCHAR *w_str_temp_buffer = GPOS_NEW_ARRAY(mp, WCHAR, m_length + 1);
+		for (ULONG ul = 0; ul < m_length; ul++)
+		{
+			GPOS_ASSERT(0 == (str[ul] & 0x80));
+			w_str_temp_buffer[ul] = (WCHAR) str[ul];
+		}
+		w_str_temp_buffer[m_length] = WCHAR_EOS;
+		m_w_str_buffer = w_str_temp_buffer;
+	}
+
+	GPOS_ASSERT(IsValid());
+}
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CWStringConst::CWStringConst
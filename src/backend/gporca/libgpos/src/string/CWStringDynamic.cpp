@@ -154,6 +154,24 @@ CWStringDynamic::AppendCharArray(const CHAR *sz)
 	{
 		IncreaseCapacity(new_length);
 	}
+
+	// 7-bit ASCII needs no conversion, widen it in place
+	ULONG ul = 0;
+	while (ul < length && 0 == (sz[ul] & 0x80))
+	{
+		m_w_str_buffer[m_length + ul] = (WCHAR) sz[ul];
+		ul++;
+	}
+
+	if (ul == length)
+	{
+		m_w_str_buffer[new_length] = WCHAR_EOS;
+		m_length = new_length;
+
+		GPOS_ASSERT(IsValid());
+		return;
+	}
+
 	WCHAR *w_str_buffer = GPOS_NEW_ARRAY(m_mp, WCHAR, length + 1);
 
 	// convert input string to wide character buffer
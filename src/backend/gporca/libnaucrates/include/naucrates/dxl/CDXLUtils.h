@@ -230,6 +230,14 @@ public:
 										  const XMLCh *xml_string,
 										  ULONG *length);
 
+	// check whether a character array holds only 7-bit ASCII characters,
+	// and compute its length
+	static BOOL IsASCII(const CHAR *c, ULONG *length);
+
+	// check whether a wide character string holds only 7-bit ASCII
+	// characters, and compute its length
+	static BOOL IsASCII(const WCHAR *wc, ULONG *length);
+
 	// create a GPOS dynamic string from a regular character array
 	static CWStringDynamic *CreateDynamicStringFromCharArray(CMemoryPool *mp,
 															 const CHAR *c);
@@ -103,6 +103,9 @@ private:
 	// private assignment operator
 	CHistogram &operator=(const CHistogram &);
 
+	// index of the first bucket that does not lie entirely before the point
+	ULONG GetFirstBucketIndexNotBefore(const CPoint *point) const;
+
 	// return an array buckets after applying equality filter on the histogram buckets
 	CBucketArray *MakeBucketsWithEqualityFilter(CPoint *point) const;
 
@@ -46,6 +46,28 @@ private:
 	// datum corresponding to the point
 	IDatum *m_datum;
 
+	// the statistics mapping of the datum, computed once when the point is
+	// created so that comparing two points does not go through the virtual
+	// functions of the datums; points are compared many times by every
+	// histogram operation
+	BOOL m_is_null;
+	BOOL m_is_mappable_to_lint;
+	BOOL m_is_mappable_to_double;
+	BOOL m_is_time_related;
+	LINT m_lint_mapping;
+	CDouble m_double_mapping;
+
+	// can the two points be compared using their pre-computed mappings;
+	// time related types of different kinds are not comparable, leave
+	// them to the datums
+	BOOL
+	IsMappedComparable(const CPoint *point) const
+	{
+		return (!m_is_time_related || !point->m_is_time_related) &&
+			   ((m_is_mappable_to_lint && point->m_is_mappable_to_lint) ||
+				(m_is_mappable_to_double && point->m_is_mappable_to_double));
+	}
+
 public:
 	// c'tor
 	explicit CPoint(IDatum *);
@@ -57,6 +79,13 @@ public:
 		return m_datum;
 	}
 
+	// does the point have a statistics mapping to LINT or double
+	BOOL
+	IsMapped() const
+	{
+		return m_is_mappable_to_lint || m_is_mappable_to_double;
+	}
+
 	// is this point equal to another
 	BOOL Equals(const CPoint *) const;
 
@@ -1493,6 +1493,60 @@ CDXLUtils::CreateStringFrom64XMLStr(
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLUtils::IsASCII
+//
+//	@doc:
+//		Check whether a character array holds only 7-bit ASCII characters,
+//		which can be widened without a locale-dependent conversion.
+//		The length of the array is returned in either case.
+//
+//---------------------------------------------------------------------------
+BOOL
+CDXLUtils::IsASCII(const CHAR *c, ULONG *length)
+{
+	GPOS_ASSERT(NULL != c);
+	GPOS_ASSERT(NULL != length);
+
+	BOOL is_ascii = true;
+	ULONG ul = 0;
+	for (; '\0' != c[ul]; ul++)
+	{
+		is_ascii = is_ascii && (0 == (c[ul] & 0x80));
+	}
+	*length = ul;
+
+	return is_ascii;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLUtils::IsASCII
+//
+//	@doc:
+//		Check whether a wide character string holds only 7-bit ASCII
+//		characters, which can be narrowed without a locale-dependent
+//		conversion. The length of the string is returned in either case.
+//
+//---------------------------------------------------------------------------
+BOOL
+CDXLUtils::IsASCII(const WCHAR *wc, ULONG *length)
+{
+	GPOS_ASSERT(NULL != wc);
+	GPOS_ASSERT(NULL != length);
+
+	BOOL is_ascii = true;
+	ULONG ul = 0;
+	for (; WCHAR_EOS != wc[ul]; ul++)
+	{
+		is_ascii = is_ascii && (0 == (wc[ul] & ~0x7F));
+	}
+	*length = ul;
+
+	return is_ascii;
+}
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CDXLUtils::CreateDynamicStringFromCharArray
@@ -1509,7 +1563,18 @@ CDXLUtils::CreateDynamicStringFromCharArray(CMemoryPool *mp, const CHAR *c)
 	GPOS_ASSERT(NULL != c);
 
 	CAutoP<CWStringDynamic> string_var(GPOS_NEW(mp) CWStringDynamic(mp));
-	string_var->AppendFormat(GPOS_WSZ_LIT("%s"), c);
+
+	ULONG length = 0;
+	if (IsASCII(c, &length))
+	{
+		// no conversion needed, skip the formatting machinery
+		string_var->AppendCharArray(c);
+	}
+	else
+	{
+		// invalid multibyte sequences are replaced by the formatter
+		string_var->AppendFormat(GPOS_WSZ_LIT("%s"), c);
+	}
 	return string_var.Reset();
 }
 
@@ -1528,6 +1593,15 @@ CDXLUtils::CreateMDNameFromCharArray(CMemoryPool *mp, const CHAR *c)
 {
 	GPOS_ASSERT(NULL != c);
 
+	ULONG length = 0;
+	if (IsASCII(c, &length))
+	{
+		// widen the name directly into the string owned by the MD name,
+		// without an intermediate dynamic string
+		return GPOS_NEW(mp)
+			CMDName(GPOS_NEW(mp) CWStringConst(mp, c, length), true);
+	}
+
 	CWStringDynamic *dxl_string =
 		CDXLUtils::CreateDynamicStringFromCharArray(mp, c);
 	CMDName *md_name = GPOS_NEW(mp) CMDName(mp, dxl_string);
@@ -1739,7 +1813,22 @@ CDXLUtils::CreateMultiByteCharStringFromWCString(CMemoryPool *mp,
 {
 	GPOS_ASSERT(NULL != wc);
 
-	ULONG max_length = GPOS_WSZ_LENGTH(wc) * GPOS_SIZEOF(WCHAR) + 1;
+	ULONG length = 0;
+	if (IsASCII(wc, &length))
+	{
+		// no conversion needed, and the result has exactly one byte per
+		// character
+		CHAR *c = GPOS_NEW_ARRAY(mp, CHAR, length + 1);
+		for (ULONG ul = 0; ul < length; ul++)
+		{
+			c[ul] = (CHAR) wc[ul];
+		}
+		c[length] = '\0';
+
+		return c;
+	}
+
+	ULONG max_length = length * GPOS_SIZEOF(WCHAR) + 1;
 	CHAR *c = GPOS_NEW_ARRAY(mp, CHAR, max_length);
 	CAutoRg<CHAR> char_wrapper(c);
 
@@ -164,6 +164,39 @@ CHistogram::IsEmpty() const
 			CStatistics::Epsilon > m_distinct_remaining);
 }
 
+// index of the first bucket that does not lie entirely before the point;
+// buckets are sorted and disjoint, so binary search skips the buckets before
+// the point instead of comparing the point with each of them. Points without
+// a statistics mapping may compare inconsistently, start at the first bucket
+// for them
+ULONG
+CHistogram::GetFirstBucketIndexNotBefore(const CPoint *point) const
+{
+	GPOS_ASSERT(NULL != point);
+
+	if (!point->IsMapped())
+	{
+		return 0;
+	}
+
+	ULONG low = 0;
+	ULONG high = m_histogram_buckets->Size();
+	while (low < high)
+	{
+		ULONG mid = low + (high - low) / 2;
+		if ((*m_histogram_buckets)[mid]->IsAfter(point))
+		{
+			low = mid + 1;
+		}
+		else
+		{
+			high = mid;
+		}
+	}
+
+	return low;
+}
+
 // construct new histogram with less than or less than equal to filter
 CHistogram *
 CHistogram::MakeHistogramLessThanOrLessThanEqualFilter(
@@ -300,10 +333,17 @@ CHistogram::MakeBucketsWithEqualityFilter(CPoint *point) const
 	const ULONG num_buckets = m_histogram_buckets->Size();
 	ULONG bucket_index = 0;
 
-	for (bucket_index = 0; bucket_index < num_buckets; bucket_index++)
+	for (bucket_index = GetFirstBucketIndexNotBefore(point);
+		 bucket_index < num_buckets; bucket_index++)
 	{
 		CBucket *bucket = (*m_histogram_buckets)[bucket_index];
 
+		if (point->IsMapped() && bucket->IsBefore(point))
+		{
+			// point falls between two buckets
+			break;
+		}
+
 		if (bucket->Contains(point))
 		{
 			if (bucket->IsSingleton())
@@ -402,7 +442,8 @@ CHistogram::MakeHistogramGreaterThanOrGreaterThanEqualFilter(
 
 	// find first bucket that contains point
 	ULONG bucket_index = 0;
-	for (bucket_index = 0; bucket_index < num_buckets; bucket_index++)
+	for (bucket_index = GetFirstBucketIndexNotBefore(point);
+		 bucket_index < num_buckets; bucket_index++)
 	{
 		CBucket *bucket = (*m_histogram_buckets)[bucket_index];
 		if (bucket->IsBefore(point))
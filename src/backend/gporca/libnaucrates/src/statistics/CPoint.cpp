@@ -14,6 +14,7 @@
 #include "gpos/base.h"
 
 #include "gpopt/mdcache/CMDAccessor.h"
+#include "naucrates/md/CMDTypeGenericGPDB.h"
 #include "naucrates/statistics/CStatistics.h"
 
 using namespace gpnaucrates;
@@ -29,9 +30,34 @@ FORCE_GENERATE_DBGSTR(CPoint);
 //		Ctor
 //
 //---------------------------------------------------------------------------
-CPoint::CPoint(IDatum *datum) : m_datum(datum)
+CPoint::CPoint(IDatum *datum)
+	: m_datum(datum),
+	  m_is_null(false),
+	  m_is_mappable_to_lint(false),
+	  m_is_mappable_to_double(false),
+	  m_is_time_related(false),
+	  m_lint_mapping(0),
+	  m_double_mapping(0.0)
 {
 	GPOS_ASSERT(NULL != m_datum);
+
+	m_is_null = m_datum->IsNull();
+	m_is_mappable_to_lint = m_datum->IsDatumMappableToLINT();
+	m_is_mappable_to_double = m_datum->IsDatumMappableToDouble();
+	m_is_time_related =
+		CMDTypeGenericGPDB::IsTimeRelatedType(m_datum->MDId());
+
+	if (!m_is_null)
+	{
+		if (m_is_mappable_to_lint)
+		{
+			m_lint_mapping = m_datum->GetLINTMapping();
+		}
+		if (m_is_mappable_to_double)
+		{
+			m_double_mapping = m_datum->GetDoubleMapping();
+		}
+	}
 }
 
 //---------------------------------------------------------------------------
@@ -46,7 +72,26 @@ BOOL
 CPoint::Equals(const CPoint *point) const
 {
 	GPOS_ASSERT(NULL != point);
-	return m_datum->StatsAreEqual(point->m_datum);
+
+	if (!IsMappedComparable(point))
+	{
+		return m_datum->StatsAreEqual(point->m_datum);
+	}
+
+	// same as IDatum::StatsAreEqual on the pre-computed mappings
+	if (m_is_null || point->m_is_null)
+	{
+		// nulls are equal from stats point of view
+		return m_is_null && point->m_is_null;
+	}
+
+	if (m_is_mappable_to_lint && point->m_is_mappable_to_lint)
+	{
+		return m_lint_mapping == point->m_lint_mapping;
+	}
+
+	CDouble diff = m_double_mapping - point->m_double_mapping;
+	return diff.Absolute() <= CStatistics::Epsilon;
 }
 
 //---------------------------------------------------------------------------
@@ -75,8 +120,32 @@ BOOL
 CPoint::IsLessThan(const CPoint *point) const
 {
 	GPOS_ASSERT(NULL != point);
-	return m_datum->StatsAreComparable(point->m_datum) &&
-		   m_datum->StatsAreLessThan(point->m_datum);
+
+	if (!IsMappedComparable(point))
+	{
+		return m_datum->StatsAreComparable(point->m_datum) &&
+			   m_datum->StatsAreLessThan(point->m_datum);
+	}
+
+	// same as IDatum::StatsAreLessThan on the pre-computed mappings
+	if (m_is_null)
+	{
+		// nulls are less than everything else except nulls
+		return !point->m_is_null;
+	}
+
+	if (point->m_is_null)
+	{
+		return false;
+	}
+
+	if (m_is_mappable_to_lint && point->m_is_mappable_to_lint)
+	{
+		return m_lint_mapping < point->m_lint_mapping;
+	}
+
+	CDouble diff = point->m_double_mapping - m_double_mapping;
+	return diff > CStatistics::Epsilon;
 }
 
 //---------------------------------------------------------------------------
@@ -104,8 +173,15 @@ CPoint::IsLessThanOrEqual(const CPoint *point) const
 BOOL
 CPoint::IsGreaterThan(const CPoint *point) const
 {
-	return m_datum->StatsAreComparable(point->m_datum) &&
-		   m_datum->StatsAreGreaterThan(point->m_datum);
+	GPOS_ASSERT(NULL != point);
+
+	if (!IsMappedComparable(point))
+	{
+		return m_datum->StatsAreComparable(point->m_datum) &&
+			   m_datum->StatsAreGreaterThan(point->m_datum);
+	}
+
+	return point->IsLessThan(this);
 }
 
 //---------------------------------------------------------------------------
@@ -139,11 +215,30 @@ CPoint::Width(const CPoint *point, BOOL include_lower, BOOL include_upper) const
 	CDouble width = CDouble(1.0);
 	CDouble adjust = CDouble(0.0);
 	GPOS_ASSERT(NULL != point);
-	if (m_datum->StatsAreComparable(point->m_datum))
+	BOOL is_mapped_comparable = IsMappedComparable(point);
+	if (is_mapped_comparable ||
+		m_datum->StatsAreComparable(point->m_datum))
 	{
 		// default case [this, point) or (this, point]
-		width = CDouble(m_datum->GetStatsDistanceFrom(point->m_datum));
-		if (m_datum->IsDatumMappableToLINT())
+		if (!is_mapped_comparable)
+		{
+			width = CDouble(m_datum->GetStatsDistanceFrom(point->m_datum));
+		}
+		else if (m_is_null || point->m_is_null)
+		{
+			// same as IDatum::GetStatsDistanceFrom
+			width = CDouble(m_is_null && point->m_is_null ? 1.0 : 0.0);
+		}
+		else if (m_is_mappable_to_lint && point->m_is_mappable_to_lint)
+		{
+			width = CDouble(m_lint_mapping - point->m_lint_mapping);
+		}
+		else
+		{
+			width = m_double_mapping - point->m_double_mapping;
+		}
+
+		if (m_is_mappable_to_lint)
 		{
 			adjust = CDouble(1.0);
 		}
@@ -152,7 +247,7 @@ CPoint::Width(const CPoint *point, BOOL include_lower, BOOL include_upper) const
 			// for the case of doubles, the distance could be any point along
 			// between the int values, so make a small adjust by a factor of
 			// 10 * Epsilon (as anything smaller than Epsilon is treated as 0)
-			GPOS_ASSERT(m_datum->IsDatumMappableToDouble());
+			GPOS_ASSERT(m_is_mappable_to_double);
 			adjust = CStatistics::Epsilon * 10;
 		}
 	}
@@ -87,6 +87,8 @@ CDXLTokens::Init(CMemoryPool *mp)
 		 GPOS_WSZ_LIT("PushGroupByBelowSetopThreshold")},
 		{EdxltokenXformBindThreshold, GPOS_WSZ_LIT("XformBindThreshold")},
 		{EdxltokenSkewFactor, GPOS_WSZ_LIT("SkewFactor")},
+		{EdxltokenSearchTimeBudget, GPOS_WSZ_LIT("SearchTimeBudget")},
+		{EdxltokenSearchMemoryBudget, GPOS_WSZ_LIT("SearchMemoryBudget")},
 		{EdxltokenWindowOids, GPOS_WSZ_LIT("WindowOids")},
 		{EdxltokenOidRowNumber, GPOS_WSZ_LIT("RowNumber")},
 		{EdxltokenOidRank, GPOS_WSZ_LIT("Rank")},
@@ -0,0 +1,327 @@
+#!/usr/bin/env python
+#
+# Measures optimization time of GPORCA by replaying minidumps with gporca_test.
+# Run ./orca_bench.py --help for detailed description
+#
+# usage: orca_bench.py run --binary build/server/gporca_test --output base.json
+#        orca_bench.py run --binary other/server/gporca_test --output new.json
+#        orca_bench.py compare base.json new.json
+#
+
+import argparse
+import glob
+import json
+import math
+import os
+import re
+import subprocess
+import sys
+
+_help = """
+Replays a set of minidumps through the optimizer and reports, for each
+minidump, the optimization time per search stage broken down into
+exploration, statistics derivation, implementation and optimization, the
+number of memo groups and group expressions, and the largest memory
+consumption reported during optimization.  Results are written as JSON (or
+CSV) so that the results of two builds can be compared with the 'compare'
+command.
+"""
+
+# trace flag EopttracePrintOptimizationStatistics
+TRACE_OPT_STATS = "101012"
+
+SCRIPT_DIR = os.path.dirname(os.path.abspath(__file__))
+GPORCA_DIR = os.path.dirname(SCRIPT_DIR)
+DEFAULT_MDP_DIR = os.path.join(GPORCA_DIR, "data", "dxl", "minidump")
+SERVER_CMAKELISTS = os.path.join(GPORCA_DIR, "server", "CMakeLists.txt")
+
+# metrics whose values are times, and vary from run to run
+TIME_METRICS = ["minidump_ms", "optimization_ms", "exploration_ms", "stats_ms",
+                "implementation_ms", "search_ms"]
+
+# metrics written for each minidump, in CSV column order
+METRICS = TIME_METRICS + ["stages", "groups", "group_exprs",
+                          "duplicate_groups", "peak_memory_mb"]
+
+re_minidump_timer = re.compile(r"timer:Minidump: (\d+)ms")
+re_total_timer = re.compile(r"\[OPT\]: Total Optimization Time: (\d+)ms")
+re_stats_timer = re.compile(
+    r"\[OPT\]: Statistics Derivation Time \(stage (\d+)\) : (\d+)ms")
+re_exploration = re.compile(
+    r"\[OPT\]: Exploration \(stage (\d+)\) completed in (\d+) msec")
+re_implementation = re.compile(
+    r"\[OPT\]: Implementation \(stage (\d+)\) completed in (\d+) msec")
+re_stage = re.compile(r"\[OPT\]: stage (\d+) completed in (\d+) msec")
+re_memo = re.compile(
+    r"\[OPT\]: Memo \(stage (\d+)\): \[(\d+) groups, (\d+) duplicate groups, "
+    r"(\d+) group expressions")
+re_memory = re.compile(r"Total: \[([0-9.eE+-]+)\] MB")
+
+
+def mdp_groups():
+    """Returns the minidump test groups defined in server/CMakeLists.txt"""
+    with open(SERVER_CMAKELISTS, "r") as fp:
+        content = fp.read()
+
+    m = re.search(r'set\(MDP_GROUPS "(.*?)"\)', content, re.S)
+    if not m:
+        return {}
+
+    groups = {}
+    text = re.sub(r"/\*.*?\*/", "", m.group(1), flags=re.S)
+    for group in text.split(";"):
+        if ":" not in group:
+            continue
+        name, files = group.split(":", 1)
+        groups[name.strip()] = files.split()
+    return groups
+
+
+def select_minidumps(args):
+    """Returns the paths of the minidumps selected by the command line"""
+    names = []
+    if args.group:
+        groups = mdp_groups()
+        for group in args.group:
+            if group not in groups:
+                sys.exit("unknown minidump test group: %s" % group)
+            names.extend(groups[group])
+    if args.list:
+        with open(args.list, "r") as fp:
+            for line in fp:
+                line = line.strip()
+                if line and not line.startswith("#"):
+                    names.append(line)
+
+    if names:
+        paths = []
+        for name in names:
+            if not name.endswith(".mdp"):
+                name += ".mdp"
+            paths.append(name if os.path.isabs(name) or os.path.exists(name)
+                         else os.path.join(args.minidumps, name))
+    else:
+        paths = sorted(glob.glob(os.path.join(args.minidumps, "*.mdp")))
+
+    if args.filter:
+        pattern = re.compile(args.filter)
+        paths = [p for p in paths if pattern.search(os.path.basename(p))]
+
+    return paths
+
+
+def parse_output(output):
+    """Extracts the optimization statistics from gporca_test output"""
+    result = dict((metric, 0) for metric in METRICS)
+
+    timers = [int(t) for t in re_minidump_timer.findall(output)]
+    if timers:
+        # the outermost timer includes loading the minidump
+        result["minidump_ms"] = max(timers)
+
+    totals = [int(t) for t in re_total_timer.findall(output)]
+    result["optimization_ms"] = sum(totals)
+
+    stages = {}
+    for stage, ms in re_stage.findall(output):
+        stages[int(stage)] = int(ms)
+    explored = dict((int(s), int(ms)) for s, ms in re_exploration.findall(output))
+    implemented = dict((int(s), int(ms))
+                       for s, ms in re_implementation.findall(output))
+    stats = dict((int(s), int(ms)) for s, ms in re_stats_timer.findall(output))
+
+    # exploration and implementation times are reported as time since the
+    # start of the stage; split each stage into consecutive phases
+    for stage, total_ms in stages.items():
+        exploration_ms = explored.get(stage, 0)
+        stats_ms = stats.get(stage, 0)
+        implementation_done = implemented.get(stage, exploration_ms + stats_ms)
+        result["exploration_ms"] += exploration_ms
+        result["stats_ms"] += stats_ms
+        result["implementation_ms"] += max(
+            0, implementation_done - exploration_ms - stats_ms)
+        result["search_ms"] += max(0, total_ms - implementation_done)
+    result["stages"] = len(stages)
+
+    memo = re_memo.findall(output)
+    if memo:
+        # the memo keeps growing across stages, report its final size
+        _, groups, duplicates, exprs = memo[-1]
+        result["groups"] = int(groups)
+        result["duplicate_groups"] = int(duplicates)
+        result["group_exprs"] = int(exprs)
+
+    memory = [float(m) for m in re_memory.findall(output)]
+    if memory:
+        result["peak_memory_mb"] = max(memory)
+
+    return result
+
+
+def median(values):
+    values = sorted(values)
+    mid = len(values) // 2
+    if len(values) % 2:
+        return values[mid]
+    return (values[mid - 1] + values[mid]) / 2.0
+
+
+def run_minidump(binary, path, repeat):
+    """Optimizes a minidump 'repeat' times and returns the median times"""
+    runs = []
+    for _ in range(repeat):
+        cmd = [binary, "-d", path, "-T", TRACE_OPT_STATS]
+        p = subprocess.Popen(cmd, stdout=subprocess.PIPE,
+                             stderr=subprocess.STDOUT)
+        output = p.communicate()[0]
+        if not isinstance(output, str):
+            output = output.decode("utf-8", "replace")
+        if p.returncode != 0:
+            return {"error": "exit code %d" % p.returncode}
+        runs.append(parse_output(output))
+
+    result = runs[0]
+    for metric in TIME_METRICS:
+        result[metric] = median([r[metric] for r in runs])
+    return result
+
+
+def write_results(results, output, fmt):
+    fp = sys.stdout if output == "-" else open(output, "w")
+    try:
+        if fmt == "json":
+            json.dump(results, fp, indent=2, sort_keys=True)
+            fp.write("\n")
+        else:
+            fp.write(",".join(["minidump"] + METRICS + ["error"]) + "\n")
+            for name in sorted(results["minidumps"]):
+                r = results["minidumps"][name]
+                fp.write(",".join([name] + [str(r.get(m, "")) for m in METRICS] +
+                                  [r.get("error", "")]) + "\n")
+    finally:
+        if fp is not sys.stdout:
+            fp.close()
+
+
+def cmd_run(args):
+    paths = select_minidumps(args)
+    if not paths:
+        sys.exit("no minidumps selected")
+
+    results = {"binary": os.path.abspath(args.binary),
+               "repeat": args.repeat,
+               "minidumps": {}}
+    for i, path in enumerate(paths):
+        name = os.path.splitext(os.path.basename(path))[0]
+        r = run_minidump(args.binary, path, args.repeat)
+        results["minidumps"][name] = r
+        if args.verbose:
+            sys.stderr.write("[%d/%d] %s: %s\n" % (
+                i + 1, len(paths), name,
+                r.get("error") or "%d ms" % r["optimization_ms"]))
+
+    write_results(results, args.output, args.format)
+
+    failed = [n for n, r in results["minidumps"].items() if "error" in r]
+    if failed:
+        sys.stderr.write("%d minidumps failed: %s\n" %
+                         (len(failed), " ".join(sorted(failed))))
+        return 1
+    return 0
+
+
+def cmd_compare(args):
+    with open(args.base, "r") as fp:
+        base = json.load(fp)["minidumps"]
+    with open(args.new, "r") as fp:
+        new = json.load(fp)["minidumps"]
+
+    metric = args.metric
+    rows = []
+    for name in sorted(set(base) & set(new)):
+        b, n = base[name], new[name]
+        if "error" in b or "error" in n:
+            continue
+        # ignore minidumps too fast to be measured reliably
+        if max(b[metric], n[metric]) < args.min_value:
+            continue
+        ratio = float(n[metric] + 1) / float(b[metric] + 1)
+        rows.append((name, b[metric], n[metric], ratio))
+
+    if not rows:
+        sys.exit("no comparable minidumps")
+
+    regressions = [r for r in rows if r[3] > 1 + args.threshold / 100.0]
+
+    print("%-60s %12s %12s %8s" % ("minidump", "base", "new", "ratio"))
+    for name, b, n, ratio in sorted(rows, key=lambda r: -r[3]):
+        if args.all or ratio > 1 + args.threshold / 100.0 or \
+                ratio < 1 - args.threshold / 100.0:
+            print("%-60s %12s %12s %8.3f" % (name, b, n, ratio))
+
+    geomean = math.exp(sum(math.log(r[3]) for r in rows) / len(rows))
+    print("")
+    print("%s: %d minidumps compared, geometric mean ratio %.3f, "
+          "%d above %d%% threshold" % (metric, len(rows), geomean,
+                                       len(regressions), args.threshold))
+
+    return 1 if regressions and args.fail_on_regression else 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description=_help)
+    subparsers = parser.add_subparsers(dest="command")
+
+    run = subparsers.add_parser("run", help="optimize minidumps and record "
+                                            "optimization statistics")
+    run.add_argument("--binary", required=True,
+                     help="path to the gporca_test executable")
+    run.add_argument("--minidumps", default=DEFAULT_MDP_DIR,
+                     help="directory holding the minidumps "
+                          "(default: %(default)s)")
+    run.add_argument("--group", action="append",
+                     help="minidump test group from server/CMakeLists.txt, "
+                          "for example CJoinOrderDPTest; may be repeated")
+    run.add_argument("--list",
+                     help="file with minidump names, one per line")
+    run.add_argument("--filter",
+                     help="regular expression on minidump file names")
+    run.add_argument("--repeat", type=int, default=3,
+                     help="runs per minidump; times are the median "
+                          "(default: %(default)s)")
+    run.add_argument("--format", choices=["json", "csv"], default="json")
+    run.add_argument("--output", default="-",
+                     help="output file (default: stdout)")
+    run.add_argument("--verbose", action="store_true",
+                     help="print progress to stderr")
+
+    compare = subparsers.add_parser("compare", help="compare the JSON results "
+                                                    "of two runs")
+    compare.add_argument("base", help="results of the baseline build")
+    compare.add_argument("new", help="results of the new build")
+    compare.add_argument("--metric", default="optimization_ms",
+                         choices=METRICS,
+                         help="metric to compare (default: %(default)s)")
+    compare.add_argument("--threshold", type=int, default=10,
+                         help="report changes larger than this percentage "
+                              "(default: %(default)s)")
+    compare.add_argument("--min-value", type=float, default=5,
+                         help="skip minidumps where both values are below "
+                              "this (default: %(default)s)")
+    compare.add_argument("--all", action="store_true",
+                         help="list all minidumps, not only changed ones")
+    compare.add_argument("--fail-on-regression", action="store_true",
+                         help="exit with 1 if any minidump regressed beyond "
+                              "the threshold")
+
+    args = parser.parse_args()
+    if args.command == "run":
+        return cmd_run(args)
+    elif args.command == "compare":
+        return cmd_compare(args)
+    parser.print_help()
+    return 2
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -36,6 +36,9 @@ public:
 
 	static GPOS_RESULT EresUnittest_CPointBool();
 
+	// pre-computed mapping tests
+	static GPOS_RESULT EresUnittest_CPointMapping();
+
 };	// class CPointTest
 }  // namespace gpnaucrates
 
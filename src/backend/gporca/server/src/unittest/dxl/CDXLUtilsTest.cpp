@@ -25,6 +25,7 @@
 #include "naucrates/dxl/CDXLUtils.h"
 #include "naucrates/dxl/xml/CDXLMemoryManager.h"
 #include "naucrates/dxl/xml/CXMLSerializer.h"
+#include "naucrates/md/CMDName.h"
 
 XERCES_CPP_NAMESPACE_USE
 
@@ -50,6 +51,7 @@ CDXLUtilsTest::EresUnittest()
 		GPOS_UNITTEST_FUNC(CDXLUtilsTest::EresUnittest_SerializeQuery),
 		GPOS_UNITTEST_FUNC(CDXLUtilsTest::EresUnittest_SerializePlan),
 		GPOS_UNITTEST_FUNC(CDXLUtilsTest::EresUnittest_Encoding),
+		GPOS_UNITTEST_FUNC(CDXLUtilsTest::EresUnittest_StringConversion),
 	};
 
 	return CUnittest::EresExecute(rgut, GPOS_ARRAY_SIZE(rgut));
@@ -231,4 +233,64 @@ CDXLUtilsTest::EresUnittest_Encoding()
 	return GPOS_OK;
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLUtilsTest::EresUnittest_StringConversion
+//
+//	@doc:
+//		Testing conversions between character arrays, MD names and wide
+//		character strings
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CDXLUtilsTest::EresUnittest_StringConversion()
+{
+	CAutoMemoryPool amp;
+	CMemoryPool *mp = amp.Pmp();
+
+	const CHAR *rgsz[] = {"", "a", "column_name_1", "Mixed Case, Punctuation!"};
+
+	for (ULONG ul = 0; ul < GPOS_ARRAY_SIZE(rgsz); ul++)
+	{
+		const CHAR *sz = rgsz[ul];
+
+		ULONG length = gpos::ulong_max;
+		GPOS_RTL_ASSERT(CDXLUtils::IsASCII(sz, &length));
+		GPOS_RTL_ASSERT(clib::Strlen(sz) == length);
+
+		// names created through the ASCII fast path match the ones
+		// created through the formatter
+		CWStringDynamic *str = GPOS_NEW(mp) CWStringDynamic(mp);
+		str->AppendFormat(GPOS_WSZ_LIT("%s"), sz);
+
+		CWStringDynamic *str_fast =
+			CDXLUtils::CreateDynamicStringFromCharArray(mp, sz);
+		CMDName *mdname = CDXLUtils::CreateMDNameFromCharArray(mp, sz);
+		GPOS_RTL_ASSERT(str->Equals(str_fast));
+		GPOS_RTL_ASSERT(str->Equals(mdname->GetMDName()));
+
+		// and convert back to the original character array
+		CHAR *sz_back = CDXLUtils::CreateMultiByteCharStringFromWCString(
+			mp, mdname->GetMDName()->GetBuffer());
+		GPOS_RTL_ASSERT(0 == clib::Strcmp(sz, sz_back));
+
+		GPOS_DELETE_ARRAY(sz_back);
+		GPOS_DELETE(mdname);
+		GPOS_DELETE(str_fast);
+		GPOS_DELETE(str);
+	}
+
+	// characters outside of 7-bit ASCII take the locale-aware path
+	const CHAR szNonASCII[] = {'a', (CHAR) 0xC3, (CHAR) 0xA9, '\0'};
+	ULONG length = 0;
+	GPOS_RTL_ASSERT(!CDXLUtils::IsASCII(szNonASCII, &length));
+	GPOS_RTL_ASSERT(3 == length);
+
+	const WCHAR wszNonASCII[] = {GPOS_WSZ_LIT('a'), (WCHAR) 0xE9, WCHAR_EOS};
+	GPOS_RTL_ASSERT(!CDXLUtils::IsASCII(wszNonASCII, &length));
+	GPOS_RTL_ASSERT(2 == length);
+
+	return GPOS_OK;
+}
+
 // EOF
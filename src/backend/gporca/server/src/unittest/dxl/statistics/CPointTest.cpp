@@ -35,6 +35,7 @@ CPointTest::EresUnittest()
 	CUnittest rgutSharedOptCtxt[] = {
 		GPOS_UNITTEST_FUNC(CPointTest::EresUnittest_CPointInt4),
 		GPOS_UNITTEST_FUNC(CPointTest::EresUnittest_CPointBool),
+		GPOS_UNITTEST_FUNC(CPointTest::EresUnittest_CPointMapping),
 	};
 
 	CAutoMemoryPool amp;
@@ -108,4 +109,57 @@ CPointTest::EresUnittest_CPointBool()
 	return GPOS_OK;
 }
 
+// comparisons on the pre-computed mappings must agree with the datums
+GPOS_RESULT
+CPointTest::EresUnittest_CPointMapping()
+{
+	// create memory pool
+	CAutoMemoryPool amp;
+	CMemoryPool *mp = amp.Pmp();
+
+	CPoint *rgpoint[] = {
+		CTestUtils::PpointInt4NullVal(mp), CTestUtils::PpointInt4(mp, -5),
+		CTestUtils::PpointInt4(mp, 0),	   CTestUtils::PpointInt4(mp, 7),
+		CTestUtils::PpointInt8(mp, 7),	   CTestUtils::PpointInt2(mp, 9),
+	};
+	const ULONG ulPoints = GPOS_ARRAY_SIZE(rgpoint);
+
+	for (ULONG ul1 = 0; ul1 < ulPoints; ul1++)
+	{
+		GPOS_RTL_ASSERT_MSG(rgpoint[ul1]->IsMapped(),
+							"integer points must be mapped");
+
+		for (ULONG ul2 = 0; ul2 < ulPoints; ul2++)
+		{
+			IDatum *datum1 = rgpoint[ul1]->GetDatum();
+			IDatum *datum2 = rgpoint[ul2]->GetDatum();
+
+			GPOS_RTL_ASSERT_MSG(rgpoint[ul1]->Equals(rgpoint[ul2]) ==
+									datum1->StatsAreEqual(datum2),
+								"mapped equality differs from datum");
+			GPOS_RTL_ASSERT_MSG(
+				rgpoint[ul1]->IsLessThan(rgpoint[ul2]) ==
+					(datum1->StatsAreComparable(datum2) &&
+					 datum1->StatsAreLessThan(datum2)),
+				"mapped less than differs from datum");
+			GPOS_RTL_ASSERT_MSG(
+				rgpoint[ul1]->IsGreaterThan(rgpoint[ul2]) ==
+					rgpoint[ul2]->IsLessThan(rgpoint[ul1]),
+				"mapped greater than differs from less than");
+		}
+	}
+
+	// null is less than everything except null
+	GPOS_RTL_ASSERT_MSG(rgpoint[0]->IsLessThan(rgpoint[1]), "null < -5");
+	GPOS_RTL_ASSERT_MSG(rgpoint[0]->Equals(rgpoint[0]), "null == null");
+	GPOS_RTL_ASSERT_MSG(rgpoint[3]->Equals(rgpoint[4]), "int4 7 == int8 7");
+
+	for (ULONG ul = 0; ul < ulPoints; ul++)
+	{
+		rgpoint[ul]->Release();
+	}
+
+	return GPOS_OK;
+}
+
 // EOF
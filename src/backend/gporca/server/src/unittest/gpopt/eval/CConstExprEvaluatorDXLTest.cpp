@@ -51,6 +51,8 @@ CConstExprEvaluatorDXLTest::CDummyConstDXLNodeEvaluator::EvaluateExpr(
 	const gpdxl::CDXLNode * /*pdxlnExpr*/
 )
 {
+	m_ulCalls++;
+
 	const IMDTypeInt4 *pmdtypeint4 = m_pmda->PtMDType<IMDTypeInt4>();
 	pmdtypeint4->MDId()->AddRef();
 
@@ -85,6 +87,8 @@ CConstExprEvaluatorDXLTest::EresUnittest()
 										 EresUnittest_ScalarContainingVariables,
 									 gpdxl::ExmaGPOPT,
 									 gpdxl::ExmiEvalUnsupportedScalarExpr),
+			GPOS_UNITTEST_FUNC(
+				CConstExprEvaluatorDXLTest::EresUnittest_RepeatedExpression),
 		};
 
 		return CUnittest::EresExecute(rgut, GPOS_ARRAY_SIZE(rgut));
@@ -191,4 +195,51 @@ CConstExprEvaluatorDXLTest::EresUnittest_ScalarContainingVariables()
 	return GPOS_OK;
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CConstExprEvaluatorDXLTest::EresUnittest_RepeatedExpression
+//
+//	@doc:
+//		Test that evaluating an expression equal to one evaluated before
+//		returns the same result without calling the DXL evaluator again.
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CConstExprEvaluatorDXLTest::EresUnittest_RepeatedExpression()
+{
+	CTestUtils::CTestSetup testsetup;
+	CMemoryPool *mp = testsetup.Pmp();
+	CDummyConstDXLNodeEvaluator consteval(mp, testsetup.Pmda(),
+										  m_iDefaultEvalValue);
+	CConstExprEvaluatorDXL *pceeval =
+		GPOS_NEW(mp) CConstExprEvaluatorDXL(mp, testsetup.Pmda(), &consteval);
+
+	// build the same comparison twice, so that the second lookup cannot
+	// match the first expression by its address
+	CExpression *pexprFirst =
+		CUtils::PexprScalarEqCmp(mp, CUtils::PexprScalarConstInt4(mp, 200),
+								 CUtils::PexprScalarConstInt4(mp, 300));
+	CExpression *pexprSecond =
+		CUtils::PexprScalarEqCmp(mp, CUtils::PexprScalarConstInt4(mp, 200),
+								 CUtils::PexprScalarConstInt4(mp, 300));
+
+	CExpression *pexprFirstResult = pceeval->PexprEval(pexprFirst);
+	CExpression *pexprSecondResult = pceeval->PexprEval(pexprSecond);
+
+	GPOS_RESULT eres = GPOS_FAILED;
+	if (1 == consteval.UlCalls() &&
+		CUtils::Equals(pexprFirstResult, pexprSecondResult))
+	{
+		eres = GPOS_OK;
+	}
+
+	pexprFirstResult->Release();
+	pexprSecondResult->Release();
+	pexprFirst->Release();
+	pexprSecond->Release();
+	pceeval->Release();
+
+	return eres;
+}
+
 // EOF
@@ -0,0 +1,239 @@
+/*-------------------------------------------------------------------------
+ *
+ * losertree.c
+ *	  A tournament ("loser") tree for k-way merging
+ *
+ * A loser tree is a complete binary tree whose leaves are the input streams
+ * of a merge.  Each internal node remembers the loser of the match played
+ * there, and the overall winner is kept separately.  After the winning
+ * stream has advanced, only the matches on the path from its leaf to the
+ * root need to be replayed, which costs exactly ceil(log2(k)) comparisons.
+ * A binary heap needs up to twice that many to sift a replaced root down,
+ * because it compares both children at every level.
+ *
+ * Portions Copyright (c) 2012-Present Pivotal Software, Inc.
+ *
+ * IDENTIFICATION
+ *	  src/backend/lib/losertree.c
+ *
+ *-------------------------------------------------------------------------
+ */
+
+#include "postgres.h"
+
+#include "lib/losertree.h"
+
+static int	build_subtree(losertree *tree, int node);
+static void replay(losertree *tree, int source);
+
+/*
+ * The tree is stored implicitly: the internal nodes are 1 .. k-1, the leaf
+ * of stream i is node k+i, and the parent of node n is n/2.  This works for
+ * any k >= 1, not just powers of two.
+ */
+#define LEAF_NODE(tree, source)		((tree)->lt_nsources + (source))
+
+/*
+ * Does stream a win a match against stream b?  Exhausted streams (and the
+ * -1 placeholder) lose against everything, so that they sink to the bottom
+ * of the tree without calling the comparator.
+ */
+static inline bool
+beats(losertree *tree, int a, int b)
+{
+	if (a < 0 || !tree->lt_active[a])
+		return false;
+	if (b < 0 || !tree->lt_active[b])
+		return true;
+	return tree->lt_compare(a, b, tree->lt_arg) > 0;
+}
+
+/*
+ * losertree_allocate
+ *
+ * Returns a pointer to a newly-allocated loser tree for merging the given
+ * number of streams, ordered by the given comparator function, which will
+ * be invoked with the additional argument specified by 'arg'.  Initially no
+ * stream is active.
+ */
+losertree *
+losertree_allocate(int nsources, losertree_comparator compare, void *arg)
+{
+	losertree  *tree;
+
+	Assert(nsources > 0);
+
+	tree = (losertree *) palloc(offsetof(losertree, lt_losers) +
+								sizeof(int) * nsources);
+	tree->lt_nsources = nsources;
+	tree->lt_compare = compare;
+	tree->lt_arg = arg;
+	tree->lt_active = (bool *) palloc(sizeof(bool) * nsources);
+
+	losertree_reset(tree);
+
+	return tree;
+}
+
+/*
+ * losertree_reset
+ *
+ * Resets the tree to an empty state, losing its data content but not the
+ * parameters passed at allocation.
+ */
+void
+losertree_reset(losertree *tree)
+{
+	int			i;
+
+	for (i = 0; i < tree->lt_nsources; i++)
+	{
+		tree->lt_active[i] = false;
+		tree->lt_losers[i] = -1;
+	}
+	tree->lt_nactive = 0;
+	tree->lt_winner = -1;
+	tree->lt_built = false;
+}
+
+/*
+ * losertree_free
+ *
+ * Releases memory used by the given loser tree.
+ */
+void
+losertree_free(losertree *tree)
+{
+	pfree(tree->lt_active);
+	pfree(tree);
+}
+
+/*
+ * losertree_add_unordered
+ *
+ * Marks the given stream as holding a value, without playing any matches.
+ * losertree_build must be called before the winner can be fetched.
+ */
+void
+losertree_add_unordered(losertree *tree, int source)
+{
+	Assert(source >= 0 && source < tree->lt_nsources);
+	Assert(!tree->lt_active[source]);
+
+	tree->lt_active[source] = true;
+	tree->lt_nactive++;
+	tree->lt_built = false;
+}
+
+/*
+ * losertree_build
+ *
+ * Plays all matches of the tournament among the active streams.  This
+ * takes k-1 comparisons at most.
+ */
+void
+losertree_build(losertree *tree)
+{
+	tree->lt_winner = build_subtree(tree, 1);
+	tree->lt_built = true;
+}
+
+/*
+ * losertree_first
+ *
+ * Returns the stream whose current value comes first among all active
+ * streams.  The tree must not be empty.
+ */
+int
+losertree_first(losertree *tree)
+{
+	Assert(!losertree_empty(tree) && tree->lt_built);
+	Assert(tree->lt_active[tree->lt_winner]);
+
+	return tree->lt_winner;
+}
+
+/*
+ * losertree_replace_first
+ *
+ * To be called after the caller has advanced the winning stream to its next
+ * value.  Replays the matches along the path from that stream's leaf to the
+ * root.
+ */
+void
+losertree_replace_first(losertree *tree)
+{
+	Assert(!losertree_empty(tree) && tree->lt_built);
+
+	replay(tree, tree->lt_winner);
+}
+
+/*
+ * losertree_remove_first
+ *
+ * To be called when the winning stream is exhausted.  The stream is made
+ * inactive and the tournament is replayed without it.
+ */
+void
+losertree_remove_first(losertree *tree)
+{
+	int			source;
+
+	Assert(!losertree_empty(tree) && tree->lt_built);
+
+	source = tree->lt_winner;
+	tree->lt_active[source] = false;
+	tree->lt_nactive--;
+
+	replay(tree, source);
+}
+
+/*
+ * Plays the matches in the subtree rooted at the given node, records the
+ * losers, and returns the winner of the subtree.
+ */
+static int
+build_subtree(losertree *tree, int node)
+{
+	int			left;
+	int			right;
+
+	if (node >= tree->lt_nsources)
+		return node - tree->lt_nsources;
+
+	left = build_subtree(tree, 2 * node);
+	right = build_subtree(tree, 2 * node + 1);
+
+	if (beats(tree, right, left))
+	{
+		tree->lt_losers[node] = left;
+		return right;
+	}
+
+	tree->lt_losers[node] = right;
+	return left;
+}
+
+/*
+ * Replays the matches from the given stream's leaf up to the root, letting
+ * the stream's (new) value play against the stored losers.
+ */
+static void
+replay(losertree *tree, int source)
+{
+	int			winner = source;
+	int			node;
+
+	for (node = LEAF_NODE(tree, source) / 2; node >= 1; node /= 2)
+	{
+		int			loser = tree->lt_losers[node];
+
+		if (beats(tree, loser, winner))
+		{
+			tree->lt_losers[node] = winner;
+			winner = loser;
+		}
+	}
+
+	tree->lt_winner = winner;
+}
@@ -0,0 +1,227 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include "cmockery.h"
+
+#include "../losertree.c"
+
+#include "utils/memutils.h"
+
+#define MAX_STREAMS 8
+
+/* input streams of a merge, each sorted in ascending order */
+typedef struct TestStreams
+{
+	int			nstreams;
+	int		   *values[MAX_STREAMS];
+	int			lengths[MAX_STREAMS];
+	int			pos[MAX_STREAMS];
+	int			ncompares;
+} TestStreams;
+
+static int
+compare_streams(int a, int b, void *arg)
+{
+	TestStreams *streams = (TestStreams *) arg;
+	int			va = streams->values[a][streams->pos[a]];
+	int			vb = streams->values[b][streams->pos[b]];
+
+	streams->ncompares++;
+
+	/* the smaller value comes first */
+	if (va < vb)
+		return 1;
+	if (va > vb)
+		return -1;
+	return 0;
+}
+
+/*
+ * Merge the streams with a loser tree into result, and return the number of
+ * values merged.
+ */
+static int
+merge_streams(TestStreams *streams, int *result)
+{
+	losertree  *tree;
+	int			nresult = 0;
+	int			i;
+
+	tree = losertree_allocate(streams->nstreams, compare_streams, streams);
+
+	for (i = 0; i < streams->nstreams; i++)
+	{
+		streams->pos[i] = 0;
+		if (streams->lengths[i] > 0)
+			losertree_add_unordered(tree, i);
+	}
+	losertree_build(tree);
+
+	while (!losertree_empty(tree))
+	{
+		int			source = losertree_first(tree);
+
+		result[nresult++] = streams->values[source][streams->pos[source]];
+
+		if (++streams->pos[source] < streams->lengths[source])
+			losertree_replace_first(tree);
+		else
+			losertree_remove_first(tree);
+	}
+
+	losertree_free(tree);
+
+	return nresult;
+}
+
+static void
+add_stream(TestStreams *streams, int *values, int length)
+{
+	streams->values[streams->nstreams] = values;
+	streams->lengths[streams->nstreams] = length;
+	streams->nstreams++;
+}
+
+static void
+test__losertree__Ties(void **state)
+{
+	int			s0[] = {1, 3, 3, 5};
+	int			s1[] = {1, 3, 5, 5};
+	int			s2[] = {3, 3, 3};
+	int			expected[] = {1, 1, 3, 3, 3, 3, 3, 3, 5, 5, 5};
+	int			result[lengthof(expected)];
+	TestStreams streams;
+	int			i;
+
+	memset(&streams, 0, sizeof(streams));
+	add_stream(&streams, s0, lengthof(s0));
+	add_stream(&streams, s1, lengthof(s1));
+	add_stream(&streams, s2, lengthof(s2));
+
+	assert_int_equal(merge_streams(&streams, result), lengthof(expected));
+	for (i = 0; i < lengthof(expected); i++)
+		assert_int_equal(result[i], expected[i]);
+}
+
+static void
+test__losertree__Empty(void **state)
+{
+	int			result[1];
+	TestStreams streams;
+	int			i;
+
+	/* no stream has any value */
+	memset(&streams, 0, sizeof(streams));
+	for (i = 0; i < 5; i++)
+		add_stream(&streams, NULL, 0);
+
+	assert_int_equal(merge_streams(&streams, result), 0);
+	assert_int_equal(streams.ncompares, 0);
+
+	/* a single, empty stream */
+	memset(&streams, 0, sizeof(streams));
+	add_stream(&streams, NULL, 0);
+
+	assert_int_equal(merge_streams(&streams, result), 0);
+}
+
+static void
+test__losertree__SingleStream(void **state)
+{
+	int			s0[] = {2, 4, 6};
+	int			result[lengthof(s0)];
+	TestStreams streams;
+	int			i;
+
+	memset(&streams, 0, sizeof(streams));
+	add_stream(&streams, s0, lengthof(s0));
+
+	assert_int_equal(merge_streams(&streams, result), lengthof(s0));
+	for (i = 0; i < lengthof(s0); i++)
+		assert_int_equal(result[i], s0[i]);
+	assert_int_equal(streams.ncompares, 0);
+}
+
+static void
+test__losertree__StreamsRunOutAtDifferentTimes(void **state)
+{
+	int			s0[] = {10};
+	int			s1[] = {1, 2, 3, 4, 5, 6, 7, 8};
+	int			s2[] = {0, 20, 30};
+	int			s3[] = {5, 6};
+	int			s4[] = {100, 101, 102, 103};
+	int			expected[] = {0, 1, 2, 3, 4, 5, 5, 6, 6, 7, 8, 10, 20, 30,
+							  100, 101, 102, 103};
+	int			result[lengthof(expected)];
+	TestStreams streams;
+	int			i;
+
+	/* a non-power-of-two number of streams, with empty ones in between */
+	memset(&streams, 0, sizeof(streams));
+	add_stream(&streams, s0, lengthof(s0));
+	add_stream(&streams, NULL, 0);
+	add_stream(&streams, s1, lengthof(s1));
+	add_stream(&streams, s2, lengthof(s2));
+	add_stream(&streams, NULL, 0);
+	add_stream(&streams, s3, lengthof(s3));
+	add_stream(&streams, s4, lengthof(s4));
+
+	assert_int_equal(merge_streams(&streams, result), lengthof(expected));
+	for (i = 0; i < lengthof(expected); i++)
+		assert_int_equal(result[i], expected[i]);
+}
+
+static void
+test__losertree__ReplaceComparisons(void **state)
+{
+	int			values[MAX_STREAMS][2];
+	int			result[2 * MAX_STREAMS];
+	TestStreams streams;
+	losertree  *tree;
+	int			i;
+
+	memset(&streams, 0, sizeof(streams));
+	for (i = 0; i < MAX_STREAMS; i++)
+	{
+		values[i][0] = i;
+		values[i][1] = MAX_STREAMS + i;
+		add_stream(&streams, values[i], 2);
+	}
+
+	tree = losertree_allocate(streams.nstreams, compare_streams, &streams);
+	for (i = 0; i < streams.nstreams; i++)
+		losertree_add_unordered(tree, i);
+	losertree_build(tree);
+	assert_int_equal(losertree_first(tree), 0);
+
+	/* replacing the winner replays only the log2(8) matches on its path */
+	streams.ncompares = 0;
+	streams.pos[0]++;
+	losertree_replace_first(tree);
+	assert_int_equal(streams.ncompares, 3);
+	assert_int_equal(losertree_first(tree), 1);
+
+	losertree_free(tree);
+
+	assert_int_equal(merge_streams(&streams, result), 2 * MAX_STREAMS);
+	for (i = 0; i < 2 * MAX_STREAMS; i++)
+		assert_int_equal(result[i], i);
+}
+
+int
+main(int argc, char *argv[])
+{
+	cmockery_parse_arguments(argc, argv);
+
+	const		UnitTest tests[] = {
+		unit_test(test__losertree__Ties),
+		unit_test(test__losertree__Empty),
+		unit_test(test__losertree__SingleStream),
+		unit_test(test__losertree__StreamsRunOutAtDifferentTimes),
+		unit_test(test__losertree__ReplaceComparisons)
+	};
+
+	MemoryContextInit();
+
+	return run_tests(tests);
+}
@@ -21,21 +21,90 @@
 
 #include "postgres.h"
 
+#include "access/hash.h"
 #include "cdb/cdbmutate.h"		/* apply_shareinput */
+#include "cdb/cdbutil.h"
 #include "cdb/cdbvars.h"
+#include "lib/ilist.h"
 #include "nodes/makefuncs.h"
+#include "optimizer/clauses.h"
 #include "optimizer/orca.h"
 #include "optimizer/paths.h"
 #include "optimizer/planmain.h"
 #include "optimizer/planner.h"
 #include "optimizer/transform.h"
 #include "portability/instr_time.h"
+#include "utils/catcache.h"
 #include "utils/guc.h"
+#include "utils/guc_tables.h"
+#include "utils/hsearch.h"
+#include "utils/inval.h"
 #include "utils/lsyscache.h"
+#include "utils/memutils.h"
+#include "utils/syscache.h"
 
 /* GPORCA entry point */
 extern PlannedStmt * GPOPTOptimizedPlan(Query *parse, bool *had_unexpected_failure);
 
+/*
+ * ORCA plan cache
+ *
+ * Applications often send the same statements over and over again without
+ * preparing them, and each one pays for a full ORCA optimization.  To avoid
+ * that, we keep the finished PlannedStmts of recent SELECT statements in a
+ * backend-local cache, keyed by the constant-folded Query tree, the values of
+ * the GUCs that ORCA reads, and the number of segments.  The cache is bounded
+ * by optimizer_plan_cache_size entries and evicts the least recently used.
+ *
+ * Entries are invalidated through the relcache and syscache invalidation
+ * callbacks, on the same catalogs that the ORCA metadata cache watches (see
+ * register_mdcache_invalidation_callbacks()): a relcache invalidation drops
+ * the plans that depend on that relation, and any change to types,
+ * operators, functions, statistics and so on drops all plans.
+ */
+typedef struct OrcaPlanCacheEntry
+{
+	uint32		hashkey;		/* hash of the fields below; must be first */
+	char	   *query_str;		/* nodeToString() of the folded Query */
+	uint32		guc_hash;		/* fingerprint of ORCA related GUCs */
+	int			nsegments;		/* cluster size the plan was made for */
+	PlannedStmt *plan;			/* the plan, allocated in 'context' */
+	MemoryContext context;		/* holds query_str and plan */
+	dlist_node	lru_node;		/* position in orca_plan_cache_lru */
+} OrcaPlanCacheEntry;
+
+/* Lookup key computed for a query before it is optimized */
+typedef struct OrcaPlanCacheProbe
+{
+	bool		cacheable;
+	uint32		hashkey;
+	char	   *query_str;
+	uint32		guc_hash;
+	int			nsegments;
+	uint64		generation;
+} OrcaPlanCacheProbe;
+
+static HTAB *orca_plan_cache = NULL;
+static MemoryContext orca_plan_cache_context = NULL;
+static dlist_head orca_plan_cache_lru = DLIST_STATIC_INIT(orca_plan_cache_lru);
+static int	orca_plan_cache_entries = 0;
+
+/*
+ * Bumped on every invalidation, so that a plan whose optimization overlapped
+ * an invalidation event is not added to the cache.
+ */
+static uint64 orca_plan_cache_generation = 0;
+static bool orca_plan_cache_callbacks_registered = false;
+
+static void orca_plan_cache_probe(Query *query, OrcaPlanCacheProbe *probe);
+static PlannedStmt *orca_plan_cache_lookup(OrcaPlanCacheProbe *probe);
+static void orca_plan_cache_insert(OrcaPlanCacheProbe *probe, PlannedStmt *plan);
+static void orca_plan_cache_remove(OrcaPlanCacheEntry *entry);
+static void orca_plan_cache_reset(void);
+static uint32 orca_plan_cache_guc_hash(void);
+static void orca_plan_cache_relcache_callback(Datum arg, Oid relid);
+static void orca_plan_cache_syscache_callback(Datum arg, int cacheid, uint32 hashvalue);
+
 /*
  * Logging of optimization outcome
  */
@@ -89,6 +158,7 @@ optimize_query(Query *parse, ParamListInfo boundParams)
 	List		   *invalItems;
 	ListCell	   *lc;
 	ListCell	   *lp;
+	OrcaPlanCacheProbe probe;
 
 	/*
 	 * Initialize a dummy PlannerGlobal struct. ORCA doesn't use it, but the
@@ -134,6 +204,15 @@ optimize_query(Query *parse, ParamListInfo boundParams)
 	 */
 	pqueryCopy = fold_constants(root, pqueryCopy, boundParams, GPOPT_MAX_FOLDED_CONSTANT_SIZE);
 
+	/* If we have planned this very query before, reuse that plan. */
+	orca_plan_cache_probe(pqueryCopy, &probe);
+	if (probe.cacheable)
+	{
+		result = orca_plan_cache_lookup(&probe);
+		if (result)
+			return result;
+	}
+
 	/* Ok, invoke ORCA. */
 	result = GPOPTOptimizedPlan(pqueryCopy, &fUnexpectedFailure);
 
@@ -254,5 +333,285 @@ optimize_query(Query *parse, ParamListInfo boundParams)
 	result->oneoffPlan = glob->oneoffPlan;
 	result->transientPlan = glob->transientPlan;
 
+	if (probe.cacheable)
+		orca_plan_cache_insert(&probe, result);
+
+	return result;
+}
+
+/*
+ * Compute the plan cache key for a (constant-folded) query, and decide
+ * whether its plan may be cached at all.
+ *
+ * Only plain SELECTs are cached.  Queries that still contain stable or
+ * volatile functions after constant folding are not, because ORCA may
+ * evaluate such expressions at plan time, e.g. for partition elimination.
+ */
+static void
+orca_plan_cache_probe(Query *query, OrcaPlanCacheProbe *probe)
+{
+	probe->cacheable = false;
+
+	if (optimizer_plan_cache_size <= 0)
+	{
+		if (orca_plan_cache_entries > 0)
+			orca_plan_cache_reset();
+		return;
+	}
+
+	if (query->commandType != CMD_SELECT ||
+		query->utilityStmt != NULL ||
+		query->parentStmtType != PARENTSTMTTYPE_NONE ||
+		query->rowMarks != NIL ||
+		query->hasModifyingCTE)
+		return;
+
+	if (contain_mutable_functions((Node *) query))
+		return;
+
+	if (!orca_plan_cache_callbacks_registered)
+	{
+		int			metadata_caches[] = {
+			AGGFNOID,
+			AMOPOPID,
+			CASTSOURCETARGET,
+			CONSTROID,
+			OPEROID,
+			OPFAMILYOID,
+			PARTOID,
+			PARTRULEOID,
+			STATRELATTINH,
+			TYPEOID,
+			PROCOID
+		};
+		int			i;
+
+		for (i = 0; i < lengthof(metadata_caches); i++)
+			CacheRegisterSyscacheCallback(metadata_caches[i],
+										  orca_plan_cache_syscache_callback,
+										  (Datum) 0);
+		CacheRegisterRelcacheCallback(orca_plan_cache_relcache_callback,
+									  (Datum) 0);
+		orca_plan_cache_callbacks_registered = true;
+	}
+
+	probe->query_str = nodeToString(query);
+	probe->guc_hash = orca_plan_cache_guc_hash();
+	probe->nsegments = getgpsegmentCount();
+	probe->hashkey = DatumGetUInt32(hash_any((unsigned char *) probe->query_str,
+											 strlen(probe->query_str)));
+	probe->hashkey ^= probe->guc_hash;
+	probe->hashkey ^= (uint32) probe->nsegments;
+	probe->generation = orca_plan_cache_generation;
+	probe->cacheable = true;
+}
+
+/*
+ * Return a copy of the cached plan for the probed query, or NULL.
+ */
+static PlannedStmt *
+orca_plan_cache_lookup(OrcaPlanCacheProbe *probe)
+{
+	OrcaPlanCacheEntry *entry;
+
+	if (orca_plan_cache == NULL)
+		return NULL;
+
+	entry = (OrcaPlanCacheEntry *) hash_search(orca_plan_cache,
+											   &probe->hashkey,
+											   HASH_FIND, NULL);
+	if (entry == NULL ||
+		entry->guc_hash != probe->guc_hash ||
+		entry->nsegments != probe->nsegments ||
+		strcmp(entry->query_str, probe->query_str) != 0)
+		return NULL;
+
+	dlist_move_head(&orca_plan_cache_lru, &entry->lru_node);
+
+	if (gp_log_optimization_time)
+		elog(LOG, "GPORCA reused a cached plan");
+	else if (optimizer_log)
+		elog(DEBUG1, "GPORCA reused a cached plan");
+
+	/* the executor may scribble on the plan, so hand out a copy */
+	return (PlannedStmt *) copyObject(entry->plan);
+}
+
+/*
+ * Remember the plan produced for the probed query.
+ */
+static void
+orca_plan_cache_insert(OrcaPlanCacheProbe *probe, PlannedStmt *plan)
+{
+	OrcaPlanCacheEntry *entry;
+	MemoryContext oldcxt;
+	bool		found;
+
+	/* don't cache plans that are only valid for this execution */
+	if (plan->oneoffPlan || plan->transientPlan)
+		return;
+
+	/* the catalogs changed while we were planning; the plan may be stale */
+	if (probe->generation != orca_plan_cache_generation)
+		return;
+
+	if (orca_plan_cache == NULL)
+	{
+		HASHCTL		ctl;
+
+		if (!CacheMemoryContext)
+			CreateCacheMemoryContext();
+
+		orca_plan_cache_context = AllocSetContextCreate(CacheMemoryContext,
+														"ORCA plan cache",
+														ALLOCSET_DEFAULT_MINSIZE,
+														ALLOCSET_DEFAULT_INITSIZE,
+														ALLOCSET_DEFAULT_MAXSIZE);
+
+		MemSet(&ctl, 0, sizeof(ctl));
+		ctl.keysize = sizeof(uint32);
+		ctl.entrysize = sizeof(OrcaPlanCacheEntry);
+		ctl.hash = oid_hash;
+		ctl.hcxt = orca_plan_cache_context;
+		orca_plan_cache = hash_create("ORCA plan cache", 256, &ctl,
+									  HASH_ELEM | HASH_FUNCTION | HASH_CONTEXT);
+	}
+
+	/* a different query with the same hash key is simply replaced */
+	entry = (OrcaPlanCacheEntry *) hash_search(orca_plan_cache,
+											   &probe->hashkey,
+											   HASH_FIND, NULL);
+	if (entry)
+		orca_plan_cache_remove(entry);
+
+	while (orca_plan_cache_entries >= optimizer_plan_cache_size)
+		orca_plan_cache_remove(dlist_container(OrcaPlanCacheEntry, lru_node,
+											   dlist_tail_node(&orca_plan_cache_lru)));
+
+	entry = (OrcaPlanCacheEntry *) hash_search(orca_plan_cache,
+											   &probe->hashkey,
+											   HASH_ENTER, &found);
+	Assert(!found);
+
+	entry->context = AllocSetContextCreate(orca_plan_cache_context,
+										   "ORCA cached plan",
+										   ALLOCSET_SMALL_MINSIZE,
+										   ALLOCSET_SMALL_INITSIZE,
+										   ALLOCSET_DEFAULT_MAXSIZE);
+	oldcxt = MemoryContextSwitchTo(entry->context);
+	entry->query_str = pstrdup(probe->query_str);
+	entry->plan = (PlannedStmt *) copyObject(plan);
+	MemoryContextSwitchTo(oldcxt);
+
+	entry->guc_hash = probe->guc_hash;
+	entry->nsegments = probe->nsegments;
+	dlist_push_head(&orca_plan_cache_lru, &entry->lru_node);
+	orca_plan_cache_entries++;
+}
+
+static void
+orca_plan_cache_remove(OrcaPlanCacheEntry *entry)
+{
+	MemoryContext context = entry->context;
+
+	dlist_delete(&entry->lru_node);
+	hash_search(orca_plan_cache, &entry->hashkey, HASH_REMOVE, NULL);
+	MemoryContextDelete(context);
+	orca_plan_cache_entries--;
+}
+
+static void
+orca_plan_cache_reset(void)
+{
+	dlist_mutable_iter iter;
+
+	dlist_foreach_modify(iter, &orca_plan_cache_lru)
+		orca_plan_cache_remove(dlist_container(OrcaPlanCacheEntry, lru_node,
+											   iter.cur));
+	Assert(orca_plan_cache_entries == 0);
+}
+
+/*
+ * Fingerprint the current values of the GUCs that influence ORCA: all the
+ * optimizer_* settings, plus a few gp_* ones that ORCA reads directly.  The
+ * size of the cache itself does not affect the plans, and resizing it must
+ * not make the plans already cached unreachable.
+ */
+static uint32
+orca_plan_cache_guc_hash(void)
+{
+	struct config_generic **gucs = get_guc_variables();
+	int			nguc = GetNumConfigOptions();
+	uint32		result = 0;
+	int			i;
+
+	for (i = 0; i < nguc; i++)
+	{
+		struct config_generic *conf = gucs[i];
+		uint32		h = 0;
+
+		if (strncmp(conf->name, "optimizer", strlen("optimizer")) != 0 &&
+			strcmp(conf->name, "gp_keep_partition_children_locks") != 0 &&
+			strcmp(conf->name, "gp_use_legacy_hashops") != 0)
+			continue;
+		if (strcmp(conf->name, "optimizer_plan_cache_size") == 0)
+			continue;
+
+		switch (conf->vartype)
+		{
+			case PGC_BOOL:
+				h = *((struct config_bool *) conf)->variable ? 1 : 2;
+				break;
+			case PGC_INT:
+				h = DatumGetUInt32(hash_uint32(*((struct config_int *) conf)->variable));
+				break;
+			case PGC_REAL:
+				h = DatumGetUInt32(hash_any((unsigned char *) ((struct config_real *) conf)->variable,
+											sizeof(double)));
+				break;
+			case PGC_STRING:
+				{
+					char	   *val = *((struct config_string *) conf)->variable;
+
+					if (val)
+						h = DatumGetUInt32(hash_any((unsigned char *) val, strlen(val)));
+				}
+				break;
+			case PGC_ENUM:
+				h = DatumGetUInt32(hash_uint32(*((struct config_enum *) conf)->variable));
+				break;
+		}
+
+		/* rotate, so that the order of the settings matters */
+		result = ((result << 1) | (result >> 31)) ^ h;
+	}
+
 	return result;
 }
+
+static void
+orca_plan_cache_relcache_callback(Datum arg, Oid relid)
+{
+	dlist_mutable_iter iter;
+
+	orca_plan_cache_generation++;
+
+	dlist_foreach_modify(iter, &orca_plan_cache_lru)
+	{
+		OrcaPlanCacheEntry *entry = dlist_container(OrcaPlanCacheEntry, lru_node,
+													iter.cur);
+
+		if (!OidIsValid(relid) ||
+			list_member_oid(entry->plan->relationOids, relid))
+			orca_plan_cache_remove(entry);
+	}
+}
+
+static void
+orca_plan_cache_syscache_callback(Datum arg, int cacheid, uint32 hashvalue)
+{
+	orca_plan_cache_generation++;
+
+	if (orca_plan_cache_entries > 0)
+		orca_plan_cache_reset();
+}
@@ -646,7 +646,8 @@ static Node *makeIsNotDistinctFromNode(Node *expr, int position);
 	IDENTITY_P IF_P ILIKE IMMEDIATE IMMUTABLE IMPLICIT_P IN_P
 	INCLUDING INCREMENT INDEX INDEXES INHERIT INHERITS INITIALLY INLINE_P
 	INNER_P INOUT INPUT_P INSENSITIVE INSERT INSTEAD INT_P INTEGER
-	INTERSECT INTERVAL INTO INVOKER IS ISNULL ISOLATION
+	INTERSECT INTERVAL INTO INVOKER IO_READ_LIMIT IO_WRITE_LIMIT IS ISNULL
+	ISOLATION
 
 	JOIN
 
@@ -914,6 +915,8 @@ static Node *makeIsNotDistinctFromNode(Node *expr, int position);
 			%nonassoc INSERT
 			%nonassoc INSTEAD
 			%nonassoc INVOKER
+			%nonassoc IO_READ_LIMIT
+			%nonassoc IO_WRITE_LIMIT
 			%nonassoc ISOLATION
 			%nonassoc KEY
 			%nonassoc LANGUAGE
@@ -1502,6 +1505,14 @@ OptResourceGroupElem:
 				{
 					$$ = makeDefElem("cpuset", (Node *) makeString($2));
 				}
+			| IO_READ_LIMIT SignedIconst
+				{
+					$$ = makeDefElem("io_read_limit", (Node *) makeInteger($2));
+				}
+			| IO_WRITE_LIMIT SignedIconst
+				{
+					$$ = makeDefElem("io_write_limit", (Node *) makeInteger($2));
+				}
 			| MEMORY_SHARED_QUOTA SignedIconst
 				{
 					$$ = makeDefElem("memory_shared_quota", (Node *) makeInteger($2));
@@ -15844,6 +15855,8 @@ unreserved_keyword:
 			| INSERT
 			| INSTEAD
 			| INVOKER
+			| IO_READ_LIMIT
+			| IO_WRITE_LIMIT
 			| ISOLATION
 			| KEY
 			| LABEL
@@ -16157,6 +16170,8 @@ PartitionIdentKeyword: ABORT_P
 			| INSERT
 			| INSTEAD
 			| INVOKER
+			| IO_READ_LIMIT
+			| IO_WRITE_LIMIT
 			| ISOLATION
 			| KEY
 			| LANGUAGE
@@ -52,6 +52,7 @@
 #include "storage/smgr.h"
 #include "storage/standby.h"
 #include "utils/rel.h"
+#include "utils/resgroup.h"
 #include "utils/resowner_private.h"
 #include "utils/faultinjector.h"
 #include "pgstat.h"
@@ -383,6 +384,7 @@ ReadBuffer_common(SMgrRelation smgr, char relpersistence, ForkNumber forkNum,
 	Block		bufBlock;
 	bool		found;
 	bool		isExtend;
+	bool		isRead = false;
 	/*
 	 * Temp tables in Greenplum use shared buffers so that backends executing
 	 * multiple slices of the same query can share them.
@@ -564,6 +566,7 @@ ReadBuffer_common(SMgrRelation smgr, char relpersistence, ForkNumber forkNum,
 				INSTR_TIME_SET_CURRENT(io_start);
 
 			smgrread(smgr, forkNum, blockNum, (char *) bufBlock);
+			isRead = true;
 
 			if (track_io_timing)
 			{
@@ -627,6 +630,15 @@ ReadBuffer_common(SMgrRelation smgr, char relpersistence, ForkNumber forkNum,
 	if (VacuumCostActive)
 		VacuumCostBalance += VacuumCostPageMiss;
 
+	/*
+	 * Charge a page read to the resource group io limits only now that the
+	 * buffer io lock is released, so that we may sleep if the group is over
+	 * them.  This also serves delays of writes done while evicting a buffer.
+	 * An extension is not charged here: the page is charged by mdwrite()
+	 * when it is written out.
+	 */
+	ResGroupThrottleIO(isRead ? BLCKSZ : 0, false);
+
 	TRACE_POSTGRESQL_BUFFER_READ_DONE(forkNum, blockNum,
 									  smgr->smgr_rnode.node.spcNode,
 									  smgr->smgr_rnode.node.dbNode,
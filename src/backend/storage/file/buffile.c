@@ -74,6 +74,7 @@
 #include "storage/gp_compress.h"
 #include "utils/faultinjector.h"
 #include "utils/memutils.h"
+#include "utils/resgroup.h"
 #include "utils/workfile_mgr.h"
 
 /*
@@ -431,6 +432,8 @@ BufFileLoadBuffer(BufFile *file, void* buffer, size_t bufsize)
 
 	pgBufferUsage.temp_blks_read++;
 
+	ResGroupThrottleIO(nb, false);
+
 	return nb;
 }
 
@@ -448,6 +451,8 @@ BufFileDumpBuffer(BufFile *file, const void* buffer, Size nbytes)
 	size_t bytestowrite;
 	int wrote = 0;
 
+	ResGroupThrottleIO(nbytes, true);
+
 	/*
 	 * Unlike BufFileLoadBuffer, we must dump the whole buffer.
 	 */
@@ -866,6 +871,33 @@ BufFileSeekBlock(BufFile *file, int64 blknum)
 	return BufFileSeek(file, 0 /* fileno */, blknum * BLCKSZ, SEEK_SET);
 }
 
+/*
+ * BufFilePrefetchBlock --- hint that a block will be read soon
+ *
+ * Initiates an asynchronous read of the n'th BLCKSZ-sized block of the file,
+ * so that the I/O can overlap with whatever the caller does before it seeks
+ * there.  The logical position of the file is not changed.
+ *
+ * This is a no-op for sequential (possibly compressed) files, which are read
+ * strictly in order anyway, and for blocks that are already in our buffer.
+ */
+void
+BufFilePrefetchBlock(BufFile *file, int64 blknum)
+{
+#ifdef USE_PREFETCH
+	int64		blkoffset = blknum * BLCKSZ;
+
+	if (file->state != BFS_RANDOM_ACCESS)
+		return;
+
+	if (blkoffset >= file->offset &&
+		blkoffset + BLCKSZ <= file->offset + file->nbytes)
+		return;
+
+	(void) FilePrefetch(file->file, blkoffset, BLCKSZ);
+#endif
+}
+
 /*
  * BufFileUpdateSize
  *
@@ -1118,6 +1150,8 @@ BufFileDumpCompressedBuffer(BufFile *file, const void *buffer, Size nbytes)
 			if (wrote != output.pos)
 				elog(ERROR, "could not write %d bytes to compressed temporary file: %m", (int) output.pos);
 			file->maxoffset += wrote;
+
+			ResGroupThrottleIO(wrote, true);
 		}
 	}
 
@@ -1173,6 +1207,8 @@ BufFileEndCompression(BufFile *file)
 		if (wrote != output.pos)
 			elog(ERROR, "could not write %d bytes to compressed temporary file: %m", (int) output.pos);
 		file->maxoffset += wrote;
+
+		ResGroupThrottleIO(wrote, true);
 	} while (ret > 0);
 
 	ZSTD_freeCCtx(file->zstd_context->cctx);
@@ -1229,6 +1265,8 @@ BufFileLoadCompressedBuffer(BufFile *file, void *buffer, size_t bufsize)
 			file->compressed_buffer.size = nb;
 			file->compressed_buffer.pos = 0;
 
+			ResGroupThrottleIO(nb, false);
+
 			if (nb == 0)
 				eof = true;
 		}
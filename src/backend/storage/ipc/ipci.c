@@ -63,6 +63,7 @@
 #include "cdb/memquota.h"
 #include "executor/instrument.h"
 #include "executor/spi.h"
+#include "utils/orcamdcache.h"
 #include "utils/workfile_mgr.h"
 #include "utils/session_state.h"
 #include "cdb/cdbendpoint.h"
@@ -181,6 +182,7 @@ CreateSharedMemoryAndSemaphores(int port)
 		size = add_size(size, CheckpointerShmemSize());
 		size = add_size(size, CancelBackendMsgShmemSize());
 		size = add_size(size, WorkFileShmemSize());
+		size = add_size(size, OrcaMDCacheShmemSize());
 
 #ifdef FAULT_INJECTOR
 		size = add_size(size, FaultInjector_ShmemSize());
@@ -365,6 +367,8 @@ CreateSharedMemoryAndSemaphores(int port)
 
 	FtsProbeShmemInit();
 
+	OrcaMDCacheShmemInit();
+
 #ifdef EXEC_BACKEND
 
 	/*
@@ -207,6 +207,7 @@ InitProcGlobal(void)
 	ProcGlobal->checkpointerLatch = NULL;
 
 	ProcGlobal->mppLocalProcessCounter = 0;
+	pg_atomic_init_u32(&ProcGlobal->lockWaitVersion, 0);
 
 	/*
 	 * Create and initialize all the PGPROC structures we'll need.  There are
@@ -1877,6 +1878,15 @@ CheckDeadLock(void)
 		PGSemaphoreUnlock(&MyProc->sem);
 	}
 
+	/*
+	 * We have waited for deadlock_timeout without running into a local
+	 * deadlock, tell the global deadlock detector to have a look.  Shorter
+	 * waits are not worth a collection of the global wait graph, and local
+	 * deadlocks are better broken here.
+	 */
+	if (deadlock_state != DS_HARD_DEADLOCK)
+		pg_atomic_fetch_add_u32(&ProcGlobal->lockWaitVersion, 1);
+
 	/*
 	 * And release locks.  We do this in reverse order for two reasons: (1)
 	 * Anyone else who needs more than one of the locks will be trying to lock
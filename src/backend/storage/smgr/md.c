@@ -45,6 +45,7 @@
 #include "storage/sync.h"
 #include "utils/hsearch.h"
 #include "utils/memutils.h"
+#include "utils/resgroup.h"
 #include "pg_trace.h"
 
 #include "catalog/pg_tablespace.h"
@@ -920,6 +921,12 @@ mdwrite(SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum,
 				 errhint("Check free disk space.")));
 	}
 
+	/*
+	 * Usually called with the buffer io lock held, in which case this only
+	 * charges the write and the resource group delay is served later.
+	 */
+	ResGroupThrottleIO(BLCKSZ, true);
+
 	if (!skipFsync && !SmgrIsTemp(reln))
 		register_dirty_segment(reln, forknum, v);
 }
@@ -54,6 +54,7 @@
 #include "nodes/execnodes.h"            /* Slice, SliceTable */
 #include "nodes/print.h"
 #include "optimizer/planner.h"
+#include "optimizer/walkers.h"
 #include "pgstat.h"
 #include "pg_trace.h"
 #include "parser/analyze.h"
@@ -79,7 +80,9 @@
 #include "utils/lsyscache.h"
 #include "utils/memutils.h"
 #include "utils/ps_status.h"
+#include "utils/relcache.h"
 #include "utils/snapmgr.h"
+#include "utils/syscache.h"
 #include "utils/timeout.h"
 #include "utils/timestamp.h"
 #include "mb/pg_wchar.h"
@@ -123,6 +126,9 @@ int			max_stack_depth = 100;
 /* wait N seconds to allow attach from a debugger */
 int			PostAuthDelay = 0;
 
+/* number of catalog entries prewarmed for the last dispatched plan */
+int			PlanCatalogPrewarmed = 0;
+
 /* Time between checks that the client is still connected. */
 int         client_connection_check_interval = 0;
 
@@ -257,6 +263,20 @@ static bool CheckDebugDtmActionSqlCommandTag(const char *sqlCommandTag);
 static bool CheckDebugDtmActionProtocol(DtxProtocolCommand dtxProtocolCommand,
 					DtxContextInfo *contextInfo);
 static bool renice_current_process(int nice_level);
+/*
+ * Catalog objects a dispatched plan refers to; see prewarm_plan_catalog().
+ */
+typedef struct prewarm_plan_context
+{
+	plan_tree_base_prefix base;
+	List	   *typeOids;		/* result types of expressions */
+	List	   *funcOids;		/* functions called by expressions */
+	List	   *aggOids;		/* aggregates */
+} prewarm_plan_context;
+
+static void prewarm_plan_catalog(PlannedStmt *plan);
+static bool prewarm_plan_walker(Node *node, prewarm_plan_context *context);
+static int	prewarm_syscache_oids(int cacheId, List *oids);
 
 /*
  * Change the priority of the current process to the specified level
@@ -1038,6 +1058,144 @@ pg_plan_queries(List *querytrees, int cursorOptions, ParamListInfo boundParams)
 	return stmt_list;
 }
 
+/*
+ * prewarm_plan_catalog
+ *
+ * Load the catalog entries a freshly started QE looks up one at a time when
+ * it opens the relations of a dispatched plan and initializes its
+ * expressions, with one batched index scan per catalog instead:
+ *
+ * - the pg_class and pg_attribute rows RelationBuildDesc() reads for each
+ *   relation (see RelationCachePrewarm());
+ * - the gp_distribution_policy entries GpPolicyFetch() reads for them;
+ * - the pg_type entries needed to build the tuple descriptors of the plan
+ *   nodes, and the pg_proc and pg_aggregate entries consulted to set up
+ *   function calls and aggregates.
+ *
+ * Entries already cached are not read again.  The number of entries loaded
+ * is left in PlanCatalogPrewarmed.
+ */
+static void
+prewarm_plan_catalog(PlannedStmt *plan)
+{
+	prewarm_plan_context context;
+	Oid		   *relids;
+	ListCell   *lc;
+	int			nrels = 0;
+
+	PlanCatalogPrewarmed = 0;
+
+	if (plan->relationOids != NIL)
+	{
+		relids = (Oid *) palloc(list_length(plan->relationOids) * sizeof(Oid));
+		foreach(lc, plan->relationOids)
+			relids[nrels++] = lfirst_oid(lc);
+
+		PlanCatalogPrewarmed += RelationCachePrewarm(nrels, relids);
+		PlanCatalogPrewarmed += prewarm_syscache_oids(GPPOLICYID,
+													  plan->relationOids);
+		pfree(relids);
+	}
+
+	exec_init_plan_tree_base(&context.base, plan);
+	context.typeOids = NIL;
+	context.funcOids = NIL;
+	context.aggOids = NIL;
+	(void) prewarm_plan_walker((Node *) plan->planTree, &context);
+
+	PlanCatalogPrewarmed += prewarm_syscache_oids(TYPEOID, context.typeOids);
+	PlanCatalogPrewarmed += prewarm_syscache_oids(PROCOID, context.funcOids);
+	PlanCatalogPrewarmed += prewarm_syscache_oids(AGGFNOID, context.aggOids);
+
+	list_free(context.typeOids);
+	list_free(context.funcOids);
+	list_free(context.aggOids);
+}
+
+static bool
+prewarm_plan_walker(Node *node, prewarm_plan_context *context)
+{
+	if (node == NULL)
+		return false;
+
+	switch (nodeTag(node))
+	{
+		case T_Var:
+		case T_Const:
+		case T_Param:
+		case T_RelabelType:
+		case T_CoerceViaIO:
+			context->typeOids = list_append_unique_oid(context->typeOids,
+													   exprType(node));
+			break;
+		case T_FuncExpr:
+			context->typeOids = list_append_unique_oid(context->typeOids,
+													   exprType(node));
+			context->funcOids = list_append_unique_oid(context->funcOids,
+													   ((FuncExpr *) node)->funcid);
+			break;
+		case T_OpExpr:
+		case T_DistinctExpr:
+		case T_NullIfExpr:
+			/* these share the OpExpr layout */
+			context->typeOids = list_append_unique_oid(context->typeOids,
+													   exprType(node));
+			context->funcOids = list_append_unique_oid(context->funcOids,
+													   ((OpExpr *) node)->opfuncid);
+			break;
+		case T_ScalarArrayOpExpr:
+			context->funcOids = list_append_unique_oid(context->funcOids,
+													   ((ScalarArrayOpExpr *) node)->opfuncid);
+			break;
+		case T_Aggref:
+			context->typeOids = list_append_unique_oid(context->typeOids,
+													   exprType(node));
+			context->funcOids = list_append_unique_oid(context->funcOids,
+													   ((Aggref *) node)->aggfnoid);
+			context->aggOids = list_append_unique_oid(context->aggOids,
+													  ((Aggref *) node)->aggfnoid);
+			break;
+		case T_WindowFunc:
+			context->typeOids = list_append_unique_oid(context->typeOids,
+													   exprType(node));
+			context->funcOids = list_append_unique_oid(context->funcOids,
+													   ((WindowFunc *) node)->winfnoid);
+			break;
+		default:
+			break;
+	}
+
+	return plan_tree_walker(node, prewarm_plan_walker, (void *) context);
+}
+
+/*
+ * Prewarm a single-key OID syscache with the given OIDs.
+ */
+static int
+prewarm_syscache_oids(int cacheId, List *oids)
+{
+	Datum	   *keys;
+	ListCell   *lc;
+	int			nkeys = 0;
+	int			nloaded;
+
+	if (oids == NIL)
+		return 0;
+
+	keys = (Datum *) palloc(list_length(oids) * sizeof(Datum));
+	foreach(lc, oids)
+	{
+		if (OidIsValid(lfirst_oid(lc)))
+			keys[nkeys++] = ObjectIdGetDatum(lfirst_oid(lc));
+	}
+
+	nloaded = PrewarmSysCache(cacheId, nkeys, keys);
+
+	pfree(keys);
+
+	return nloaded;
+}
+
 /*
  * exec_mpp_query
  *
@@ -1138,6 +1296,9 @@ exec_mpp_query(const char *query_string,
 		plan = (PlannedStmt *) deserializeNode(serializedPlantree,serializedPlantreelen);
 		if (!plan || !IsA(plan, PlannedStmt))
 			elog(ERROR, "MPPEXEC: receive invalid planned statement");
+
+		if (gp_catcache_prewarm)
+			prewarm_plan_catalog(plan);
     }
 
 	/*
@@ -22,6 +22,7 @@
 #include "access/tuptoaster.h"
 #include "access/valid.h"
 #include "access/xact.h"
+#include "catalog/index.h"
 #include "catalog/pg_operator.h"
 #include "catalog/pg_type.h"
 #include "miscadmin.h"
@@ -89,6 +90,8 @@ static CatCTup *CatalogCacheCreateEntry(CatCache *cache, HeapTuple ntp,
 						uint32 hashValue, Index hashIndex,
 						bool negative);
 static HeapTuple build_dummy_tuple(CatCache *cache, int nkeys, ScanKey skeys);
+static bool CatCacheContainsKey(CatCache *cache, ScanKey cur_skey,
+					uint32 *hashValue);
 
 
 /*
@@ -1286,6 +1289,162 @@ SearchCatCache(CatCache *cache,
 	return &ct->tuple;
 }
 
+/*
+ *	PrewarmCatCache
+ *
+ *	Load the entries for a set of keys of a single-key OID cache with one
+ *	index scan, rather than the one scan per key SearchCatCache would do on
+ *	the first lookup of each key.  Keys already in the cache are skipped, and
+ *	keys without a matching tuple get a negative entry, as SearchCatCache
+ *	would create.  The new entries are not pinned.
+ *
+ *	This is only an optimization; caches it doesn't apply to are left alone.
+ *	Returns the number of entries added to the cache.
+ */
+int
+PrewarmCatCache(CatCache *cache, int nkeys, Datum *keys)
+{
+	ScanKeyData cur_skey[CATCACHE_MAXKEYS];
+	Datum	   *missing;
+	int			nmissing = 0;
+	int			nloaded = 0;
+	ArrayType  *keyarray;
+	Relation	relation;
+	SysScanDesc scandesc;
+	HeapTuple	ntp;
+	int			i;
+
+	Assert(IsTransactionState());
+
+	if (nkeys <= 0 || IsBootstrapProcessingMode())
+		return 0;
+
+	if (cache->cc_tupdesc == NULL)
+		CatalogCacheInitializeCache(cache);
+
+	/*
+	 * The keys are matched with a btree array scan key, which a heap scan
+	 * can't evaluate; so the index must be usable.
+	 */
+	if (cache->cc_nkeys != 1 ||
+		(cache->cc_key[0] != ObjectIdAttributeNumber &&
+		 cache->cc_tupdesc->attrs[cache->cc_key[0] - 1]->atttypid != OIDOID &&
+		 cache->cc_tupdesc->attrs[cache->cc_key[0] - 1]->atttypid != REGPROCOID) ||
+		IgnoreSystemIndexes ||
+		!IndexScanOK(cache, NULL) ||
+		ReindexIsProcessingIndex(cache->cc_indexoid))
+		return 0;
+
+	memcpy(cur_skey, cache->cc_skey, sizeof(cur_skey));
+
+	missing = (Datum *) palloc(nkeys * sizeof(Datum));
+	for (i = 0; i < nkeys; i++)
+	{
+		uint32		hashValue;
+
+		cur_skey[0].sk_argument = keys[i];
+		if (!CatCacheContainsKey(cache, cur_skey, &hashValue))
+			missing[nmissing++] = keys[i];
+	}
+
+	if (nmissing == 0)
+	{
+		pfree(missing);
+		return 0;
+	}
+
+	keyarray = construct_array(missing, nmissing, OIDOID,
+							   sizeof(Oid), true, 'i');
+	cur_skey[0].sk_flags |= SK_SEARCHARRAY;
+	cur_skey[0].sk_argument = PointerGetDatum(keyarray);
+
+	relation = heap_open(cache->cc_reloid, AccessShareLock);
+
+	scandesc = systable_beginscan(relation,
+								  cache->cc_indexoid,
+								  true,
+								  NULL,
+								  1,
+								  cur_skey);
+
+	while (HeapTupleIsValid(ntp = systable_getnext(scandesc)))
+	{
+		uint32		hashValue = CatalogCacheComputeTupleHashValue(cache, ntp);
+
+		CatalogCacheCreateEntry(cache, ntp,
+								hashValue,
+								HASH_INDEX(hashValue, cache->cc_nbuckets),
+								false);
+		nloaded++;
+	}
+
+	systable_endscan(scandesc);
+
+	heap_close(relation, AccessShareLock);
+
+	/* Remember the keys that have no tuple */
+	cur_skey[0].sk_flags &= ~SK_SEARCHARRAY;
+	for (i = 0; i < nmissing; i++)
+	{
+		uint32		hashValue;
+
+		cur_skey[0].sk_argument = missing[i];
+		if (!CatCacheContainsKey(cache, cur_skey, &hashValue))
+		{
+			ntp = build_dummy_tuple(cache, 1, cur_skey);
+			CatalogCacheCreateEntry(cache, ntp,
+									hashValue,
+									HASH_INDEX(hashValue, cache->cc_nbuckets),
+									true);
+			heap_freetuple(ntp);
+			nloaded++;
+		}
+	}
+
+	CACHE3_elog(DEBUG2, "PrewarmCatCache(%s): loaded %d keys",
+				cache->cc_relname, nloaded);
+
+	pfree(keyarray);
+	pfree(missing);
+
+	return nloaded;
+}
+
+/*
+ * CatCacheContainsKey
+ *		Is there a live entry, positive or negative, for the given key?
+ *
+ * The key's hash value is returned in *hashValue.
+ */
+static bool
+CatCacheContainsKey(CatCache *cache, ScanKey cur_skey, uint32 *hashValue)
+{
+	dlist_iter	iter;
+	dlist_head *bucket;
+
+	*hashValue = CatalogCacheComputeHashValue(cache, cache->cc_nkeys, cur_skey);
+	bucket = &cache->cc_bucket[HASH_INDEX(*hashValue, cache->cc_nbuckets)];
+
+	dlist_foreach(iter, bucket)
+	{
+		CatCTup    *ct = dlist_container(CatCTup, cache_elem, iter.cur);
+		bool		res;
+
+		if (ct->dead || ct->hash_value != *hashValue)
+			continue;
+
+		HeapKeyTest(&ct->tuple,
+					cache->cc_tupdesc,
+					cache->cc_nkeys,
+					cur_skey,
+					res);
+		if (res)
+			return true;
+	}
+
+	return false;
+}
+
 /*
  *	ReleaseCatCache
  *
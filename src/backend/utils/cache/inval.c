@@ -847,6 +847,17 @@ MakeSharedInvalidMessagesArray(const SharedInvalidationMessage *msgs, int n)
 	numSharedInvalidMessagesArray += n;
 }
 
+/*
+ * xactHasInvalidationMessages() is called by ORCA's shared metadata cache
+ * to find out whether the committing transaction will send any
+ * invalidation messages.  It must be called before AtEOXact_Inval().
+ */
+bool
+xactHasInvalidationMessages(void)
+{
+	return transInvalInfo != NULL;
+}
+
 /*
  * xactGetCommittedInvalidationMessages() is executed by
  * RecordTransactionCommit() to add invalidation messages onto the
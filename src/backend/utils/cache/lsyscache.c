@@ -4373,24 +4373,26 @@ child_distribution_mismatch(Relation rel)
 	List *child_oids = find_all_inheritors(rel->rd_id, NoLock, NULL);
 	ListCell *lc;
 
+	/*
+	 * Read the policies from the catalog rather than from the relcache:
+	 * building relcache entries for thousands of partitions only to look at
+	 * their policy is far more expensive.
+	 */
 	foreach (lc, child_oids)
 	{
 		Oid oidChild = lfirst_oid(lc);
-		Relation relChild = RelationIdGetRelation(oidChild);
-		Assert(NULL != relChild);
-
-		GpPolicy *childPolicy = relChild->rd_cdbpolicy;
+		GpPolicy *childPolicy = GpPolicyFetch(oidChild);
 
 		Assert(!GpPolicyIsReplicated(childPolicy));
 
 		if (GpPolicyIsRandomPartitioned(childPolicy))
 		{
 			/* child partition is Random, and parent is not */
-			RelationClose(relChild);
+			pfree(childPolicy);
 			return true;
 		}
 
-		RelationClose(relChild);
+		pfree(childPolicy);
 	}
 
 	list_free(child_oids);
@@ -0,0 +1,426 @@
+/*-------------------------------------------------------------------------
+ *
+ * orcamdcache.c
+ *	  Metadata cache shared by the GPORCA instances of all backends.
+ *
+ * GPORCA keeps a metadata cache per backend (CMDCache), which starts out
+ * empty in every new session.  Filling it means translating relations,
+ * types, operators, functions and statistics from the catalogs into DXL,
+ * which makes the first queries of a session noticeably slower to plan.
+ * This module keeps the DXL strings produced by CMDProviderRelcache in
+ * shared memory on the master, so that a new session can pick up what
+ * earlier sessions have already translated.
+ *
+ * The DXL strings are stored in a circular arena.  New objects are written
+ * at the head, overwriting the oldest ones, and a hash table maps the
+ * object's key to its position.  Positions are logical, ever-increasing
+ * byte offsets, so an entry whose bytes have been overwritten is recognized
+ * by its position falling behind the head by more than the arena size.
+ *
+ * Invalidation is version-based.  The arena has a generation number, and an
+ * entry is only valid if it was created in the current generation.  Every
+ * backend bumps the generation whenever it processes an invalidation of one
+ * of the catalogs that the backend local ORCA metadata cache watches (see
+ * MDCacheNeedsReset()), which makes every cached object stale at once.  That
+ * also covers non-transactional changes, such as the in-place update of
+ * relpages and reltuples by VACUUM.  A backend that commits a transaction
+ * that sent invalidation messages bumps the generation once more right after
+ * sending them, as no other backend may be around to receive them yet.  A
+ * backend that misses in the cache
+ * remembers the generation and its own count of processed invalidation
+ * messages; after fetching the object from the catalogs it only stores it
+ * if neither has changed, so an object read from a stale catalog snapshot
+ * or a not yet invalidated syscache entry never gets into the cache.
+ *
+ * Portions Copyright (c) 2012-Present Pivotal Software, Inc.
+ *
+ * IDENTIFICATION
+ *	  src/backend/utils/cache/orcamdcache.c
+ *
+ *-------------------------------------------------------------------------
+ */
+#include "postgres.h"
+
+#include "access/xact.h"
+#include "cdb/cdbvars.h"
+#include "miscadmin.h"
+#include "port/atomics.h"
+#include "storage/lwlock.h"
+#include "storage/shmem.h"
+#include "storage/sinval.h"
+#include "utils/guc.h"
+#include "utils/hsearch.h"
+#include "utils/inval.h"
+#include "utils/orcamdcache.h"
+#include "utils/resowner.h"
+#include "utils/syscache.h"
+
+/* longest mdid string that can be cached */
+#define ORCA_MDCACHE_MDID_LEN	64
+
+/* assumed average size of a cached object, to size the hash table */
+#define ORCA_MDCACHE_AVG_OBJECT_SIZE	2048
+
+typedef struct OrcaMDCacheKey
+{
+	Oid			dbid;
+	int			mdtype;			/* IMDCacheObject::Emdtype */
+	char		mdid[ORCA_MDCACHE_MDID_LEN];
+} OrcaMDCacheKey;
+
+typedef struct OrcaMDCacheEntry
+{
+	OrcaMDCacheKey key;			/* hash key; must be first */
+	uint64		generation;		/* generation the object was fetched in */
+	uint64		pos;			/* logical position in the arena */
+	Size		len;			/* length of the object */
+} OrcaMDCacheEntry;
+
+typedef struct OrcaMDCacheCtl
+{
+	pg_atomic_uint64 generation;
+	uint64		head;			/* logical position of the next write */
+	Size		arena_size;
+	char		arena[FLEXIBLE_ARRAY_MEMBER];
+} OrcaMDCacheCtl;
+
+static OrcaMDCacheCtl *OrcaMDCache = NULL;
+static HTAB *OrcaMDCacheHash = NULL;
+
+/* invalidation messages this backend has processed for watched catalogs */
+static uint64 orca_mdcache_local_invals = 0;
+
+/* has the current transaction changed any of the watched catalogs? */
+static bool orca_mdcache_changed_in_xact = false;
+
+/* is the committing transaction sending invalidation messages? */
+static bool orca_mdcache_sent_invals = false;
+
+static void orca_mdcache_inval_callback(void);
+static void orca_mdcache_syscache_callback(Datum arg, int cacheid, uint32 hashvalue);
+static void orca_mdcache_relcache_callback(Datum arg, Oid relid);
+static void orca_mdcache_release_callback(ResourceReleasePhase phase,
+							  bool isCommit, bool isTopLevel, void *arg);
+static bool orca_mdcache_make_key(OrcaMDCacheKey *key, int mdtype, const char *mdid);
+static bool orca_mdcache_entry_valid(OrcaMDCacheEntry *entry, uint64 generation);
+static void orca_mdcache_sweep(uint64 generation);
+
+/*
+ * The cache only lives on the master, where ORCA runs.
+ */
+static Size
+orca_mdcache_arena_size(void)
+{
+	if (Gp_role != GP_ROLE_DISPATCH)
+		return 0;
+	return (Size) optimizer_mdcache_shared_size * 1024;
+}
+
+static long
+orca_mdcache_max_entries(void)
+{
+	return Max(orca_mdcache_arena_size() / ORCA_MDCACHE_AVG_OBJECT_SIZE, 256);
+}
+
+Size
+OrcaMDCacheShmemSize(void)
+{
+	Size		size;
+
+	if (orca_mdcache_arena_size() == 0)
+		return 0;
+
+	size = add_size(offsetof(OrcaMDCacheCtl, arena), orca_mdcache_arena_size());
+	size = add_size(size, hash_estimate_size(orca_mdcache_max_entries(),
+											 sizeof(OrcaMDCacheEntry)));
+	return size;
+}
+
+void
+OrcaMDCacheShmemInit(void)
+{
+	HASHCTL		info;
+	bool		found;
+	Size		arena_size = orca_mdcache_arena_size();
+
+	if (arena_size == 0)
+		return;
+
+	OrcaMDCache = (OrcaMDCacheCtl *)
+		ShmemInitStruct("ORCA shared metadata cache",
+						offsetof(OrcaMDCacheCtl, arena) + arena_size,
+						&found);
+	if (!found)
+	{
+		pg_atomic_init_u64(&OrcaMDCache->generation, 1);
+		OrcaMDCache->head = 0;
+		OrcaMDCache->arena_size = arena_size;
+	}
+
+	MemSet(&info, 0, sizeof(info));
+	info.keysize = sizeof(OrcaMDCacheKey);
+	info.entrysize = sizeof(OrcaMDCacheEntry);
+	info.hash = tag_hash;
+	OrcaMDCacheHash = ShmemInitHash("ORCA shared metadata cache index",
+									orca_mdcache_max_entries(),
+									orca_mdcache_max_entries(),
+									&info,
+									HASH_ELEM | HASH_FUNCTION);
+}
+
+/*
+ * Register the invalidation callbacks that drive the cache versions.
+ *
+ * This is done in every backend on the master, not only in the ones that
+ * run ORCA, because any backend can change the catalogs.
+ */
+void
+OrcaMDCacheInitBackend(void)
+{
+	int			metadata_caches[] = {
+		AGGFNOID,
+		AMOPOPID,
+		CASTSOURCETARGET,
+		CONSTROID,
+		OPEROID,
+		OPFAMILYOID,
+		PARTOID,
+		PARTRULEOID,
+		STATRELATTINH,
+		TYPEOID,
+		PROCOID
+	};
+	int			i;
+
+	if (OrcaMDCache == NULL)
+		return;
+
+	for (i = 0; i < lengthof(metadata_caches); i++)
+		CacheRegisterSyscacheCallback(metadata_caches[i],
+									  orca_mdcache_syscache_callback,
+									  (Datum) 0);
+	CacheRegisterRelcacheCallback(orca_mdcache_relcache_callback, (Datum) 0);
+	RegisterResourceReleaseCallback(orca_mdcache_release_callback, NULL);
+}
+
+/*
+ * Look up an object.  Returns a palloc'd copy of its DXL, or NULL if it is
+ * not cached; in that case, the versions to pass to OrcaMDCacheInsert()
+ * are returned in *version.
+ */
+char *
+OrcaMDCacheLookup(int mdtype, const char *mdid, Size *len,
+				  OrcaMDCacheVersion *version)
+{
+	OrcaMDCacheKey key;
+	OrcaMDCacheEntry *entry;
+	char	   *result = NULL;
+
+	version->generation = 0;
+	version->local_invals = orca_mdcache_local_invals;
+
+	/*
+	 * Our own uncommitted catalog changes are not reflected in the cache,
+	 * so don't use it until they are committed.
+	 */
+	if (OrcaMDCache == NULL || orca_mdcache_changed_in_xact)
+		return NULL;
+
+	if (!orca_mdcache_make_key(&key, mdtype, mdid))
+		return NULL;
+
+	version->generation = pg_atomic_read_u64(&OrcaMDCache->generation);
+
+	LWLockAcquire(OrcaMDCacheLock, LW_SHARED);
+
+	entry = (OrcaMDCacheEntry *) hash_search(OrcaMDCacheHash, &key,
+											 HASH_FIND, NULL);
+	if (entry && orca_mdcache_entry_valid(entry, version->generation))
+	{
+		result = palloc(entry->len);
+		memcpy(result, OrcaMDCache->arena + entry->pos % OrcaMDCache->arena_size,
+			   entry->len);
+		*len = entry->len;
+	}
+
+	LWLockRelease(OrcaMDCacheLock);
+
+	return result;
+}
+
+/*
+ * Add an object that was fetched from the catalogs after a miss in
+ * OrcaMDCacheLookup().
+ */
+void
+OrcaMDCacheInsert(int mdtype, const char *mdid,
+				  const OrcaMDCacheVersion *version,
+				  const char *data, Size len)
+{
+	OrcaMDCacheKey key;
+	OrcaMDCacheEntry *entry;
+	uint64		pos;
+	Size		offset;
+
+	if (OrcaMDCache == NULL || orca_mdcache_changed_in_xact ||
+		version->generation == 0)
+		return;
+
+	/* don't let a single huge object flush a large part of the cache */
+	if (len > OrcaMDCache->arena_size / 8)
+		return;
+
+	if (!orca_mdcache_make_key(&key, mdtype, mdid))
+		return;
+
+	/*
+	 * If a catalog change was committed while we were fetching the object,
+	 * we may have read it from a syscache entry that we had not invalidated
+	 * yet.  Process pending invalidations, and give up if there were any.
+	 */
+	AcceptInvalidationMessages();
+	if (orca_mdcache_local_invals != version->local_invals)
+		return;
+
+	LWLockAcquire(OrcaMDCacheLock, LW_EXCLUSIVE);
+
+	if (pg_atomic_read_u64(&OrcaMDCache->generation) != version->generation)
+	{
+		LWLockRelease(OrcaMDCacheLock);
+		return;
+	}
+
+	entry = (OrcaMDCacheEntry *) hash_search(OrcaMDCacheHash, &key,
+											 HASH_ENTER_NULL, NULL);
+	if (entry == NULL)
+	{
+		orca_mdcache_sweep(version->generation);
+		entry = (OrcaMDCacheEntry *) hash_search(OrcaMDCacheHash, &key,
+												 HASH_ENTER_NULL, NULL);
+		if (entry == NULL)
+		{
+			LWLockRelease(OrcaMDCacheLock);
+			return;
+		}
+	}
+
+	/* objects are stored contiguously; skip the tail end of the arena */
+	offset = OrcaMDCache->head % OrcaMDCache->arena_size;
+	if (offset + len > OrcaMDCache->arena_size)
+		OrcaMDCache->head += OrcaMDCache->arena_size - offset;
+
+	pos = OrcaMDCache->head;
+	OrcaMDCache->head += MAXALIGN(len);
+	memcpy(OrcaMDCache->arena + pos % OrcaMDCache->arena_size, data, len);
+
+	entry->generation = version->generation;
+	entry->pos = pos;
+	entry->len = len;
+
+	LWLockRelease(OrcaMDCacheLock);
+}
+
+static bool
+orca_mdcache_make_key(OrcaMDCacheKey *key, int mdtype, const char *mdid)
+{
+	if (strlen(mdid) >= ORCA_MDCACHE_MDID_LEN)
+		return false;
+
+	/* the key is hashed as a whole, so clear the padding */
+	MemSet(key, 0, sizeof(OrcaMDCacheKey));
+	key->dbid = MyDatabaseId;
+	key->mdtype = mdtype;
+	strcpy(key->mdid, mdid);
+
+	return true;
+}
+
+/*
+ * Is the entry current, and have its bytes not been overwritten yet?
+ * Caller must hold OrcaMDCacheLock.
+ */
+static bool
+orca_mdcache_entry_valid(OrcaMDCacheEntry *entry, uint64 generation)
+{
+	return entry->generation == generation &&
+		entry->pos + OrcaMDCache->arena_size >= OrcaMDCache->head;
+}
+
+/*
+ * Remove all invalid entries, to make room in the hash table.  Caller must
+ * hold OrcaMDCacheLock exclusively.
+ */
+static void
+orca_mdcache_sweep(uint64 generation)
+{
+	HASH_SEQ_STATUS status;
+	OrcaMDCacheEntry *entry;
+
+	hash_seq_init(&status, OrcaMDCacheHash);
+	while ((entry = (OrcaMDCacheEntry *) hash_seq_search(&status)) != NULL)
+	{
+		if (!orca_mdcache_entry_valid(entry, generation))
+			hash_search(OrcaMDCacheHash, &entry->key, HASH_REMOVE, NULL);
+	}
+}
+
+/*
+ * Invalidation callbacks.  Invalidation messages are processed both for our
+ * own changes, at command boundaries, and for those of other backends.  Any
+ * of them means that the cached objects and an object being fetched right
+ * now may be stale.  If we are in a transaction that has written to the
+ * catalogs, the message may be for our own change, which other backends
+ * will only see once we commit.
+ */
+static void
+orca_mdcache_inval_callback(void)
+{
+	orca_mdcache_local_invals++;
+	pg_atomic_fetch_add_u64(&OrcaMDCache->generation, 1);
+
+	if (TransactionIdIsValid(GetTopTransactionIdIfAny()))
+		orca_mdcache_changed_in_xact = true;
+}
+
+static void
+orca_mdcache_syscache_callback(Datum arg, int cacheid, uint32 hashvalue)
+{
+	orca_mdcache_inval_callback();
+}
+
+static void
+orca_mdcache_relcache_callback(Datum arg, Oid relid)
+{
+	orca_mdcache_inval_callback();
+}
+
+/*
+ * Bump the generation when a transaction that sent invalidation messages
+ * commits, whether or not it has an xid, as in-place updates don't need one.
+ * The bump happens after AtEOXact_Inval() has sent the messages, so a
+ * backend that misses in the cache after the bump will process them before
+ * it can store anything.
+ */
+static void
+orca_mdcache_release_callback(ResourceReleasePhase phase,
+							  bool isCommit, bool isTopLevel, void *arg)
+{
+	if (!isTopLevel)
+		return;
+
+	if (phase == RESOURCE_RELEASE_BEFORE_LOCKS)
+	{
+		/* AtEOXact_Inval() has not run yet */
+		orca_mdcache_sent_invals = isCommit && xactHasInvalidationMessages();
+		return;
+	}
+
+	if (phase != RESOURCE_RELEASE_AFTER_LOCKS)
+		return;
+
+	if (orca_mdcache_sent_invals)
+		pg_atomic_fetch_add_u64(&OrcaMDCache->generation, 1);
+
+	orca_mdcache_changed_in_xact = false;
+	orca_mdcache_sent_invals = false;
+}
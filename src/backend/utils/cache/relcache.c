@@ -243,6 +243,26 @@ typedef struct opclasscacheent
 
 static HTAB *OpClassCache = NULL;
 
+/*
+ * Catalog rows read ahead by RelationCachePrewarm() for relations that are
+ * not in the relcache yet.  When such a relation is built, its pg_class row
+ * and user attribute rows are taken from here instead of being scanned for.
+ *
+ * An entry is dropped once it has been used, and when an invalidation for
+ * its relation arrives, just like the relcache entry it stands in for.  The
+ * whole table lives in RelationPrewarmContext, under TopTransactionContext,
+ * so it disappears at end of transaction.
+ */
+typedef struct relprewarmcacheent
+{
+	Oid			relid;			/* lookup key: OID of the relation */
+	HeapTuple	pg_class_tuple;	/* the relation's pg_class row */
+	List	   *pg_attribute_tuples;	/* its pg_attribute rows, attnum > 0 */
+} RelPrewarmCacheEnt;
+
+static HTAB *RelationPrewarmCache = NULL;
+static MemoryContext RelationPrewarmContext = NULL;
+
 
 /* non-export function prototypes */
 
@@ -265,6 +285,8 @@ static void formrdesc(const char *relationName, Oid relationReltype,
 		  int natts, const FormData_pg_attribute *attrs);
 
 static HeapTuple ScanPgRelation(Oid targetRelId, bool indexOK, bool force_non_historic);
+static RelPrewarmCacheEnt *RelationPrewarmLookup(Oid relid);
+static void RelationPrewarmForget(Oid relid);
 static Relation AllocateRelationDesc(Form_pg_class relp);
 static void RelationParseRelOptions(Relation relation, HeapTuple tuple);
 static void RelationBuildTupleDesc(Relation relation);
@@ -321,6 +343,15 @@ ScanPgRelation(Oid targetRelId, bool indexOK, bool force_non_historic)
 	if (!OidIsValid(MyDatabaseId))
 		elog(FATAL, "cannot read pg_class without having selected a database");
 
+	/* Use the row read by RelationCachePrewarm(), if there is one */
+	if (indexOK && !force_non_historic)
+	{
+		RelPrewarmCacheEnt *pentry = RelationPrewarmLookup(targetRelId);
+
+		if (pentry != NULL)
+			return heap_copytuple(pentry->pg_class_tuple);
+	}
+
 	/*
 	 * form a scan key
 	 */
@@ -369,6 +400,191 @@ ScanPgRelation(Oid targetRelId, bool indexOK, bool force_non_historic)
 	return pg_class_tuple;
 }
 
+/*
+ *		RelationCachePrewarm
+ *
+ *		Read the pg_class and pg_attribute rows of the given relations that
+ *		are not in the relcache yet, with one index scan per catalog.  They
+ *		are used when the relcache entries are built, instead of the two
+ *		scans per relation RelationBuildDesc() would otherwise do.
+ *
+ *		The caller need not hold locks on the relations: the rows are
+ *		discarded when an invalidation for the relation arrives, which
+ *		happens at the latest when a lock on it is acquired.
+ *
+ *		Returns the number of relations whose rows were read.
+ */
+int
+RelationCachePrewarm(int nrels, Oid *relids)
+{
+	Datum	   *keys;
+	int			nkeys = 0;
+	int			nloaded = 0;
+	ArrayType  *keyarray;
+	ScanKeyData skey[2];
+	Relation	rel;
+	SysScanDesc scan;
+	HeapTuple	tuple;
+	MemoryContext oldcxt;
+	int			i;
+
+	Assert(IsTransactionState());
+
+	/* The keys are matched with a btree array scan key, so need the index */
+	if (nrels <= 0 || !criticalRelcachesBuilt || IgnoreSystemIndexes)
+		return 0;
+
+	keys = (Datum *) palloc(nrels * sizeof(Datum));
+	for (i = 0; i < nrels; i++)
+	{
+		Relation	relation;
+
+		RelationIdCacheLookup(relids[i], relation);
+		if (relation == NULL && RelationPrewarmLookup(relids[i]) == NULL)
+			keys[nkeys++] = ObjectIdGetDatum(relids[i]);
+	}
+
+	if (nkeys == 0)
+	{
+		pfree(keys);
+		return 0;
+	}
+
+	keyarray = construct_array(keys, nkeys, OIDOID,
+							   sizeof(Oid), true, 'i');
+
+	/* pg_class rows, as ScanPgRelation() would read them */
+	ScanKeyInit(&skey[0],
+				ObjectIdAttributeNumber,
+				BTEqualStrategyNumber, F_OIDEQ,
+				PointerGetDatum(keyarray));
+	skey[0].sk_flags |= SK_SEARCHARRAY;
+
+	rel = heap_open(RelationRelationId, AccessShareLock);
+	scan = systable_beginscan(rel, ClassOidIndexId, true,
+							  GetCatalogSnapshot(RelationRelationId),
+							  1, skey);
+
+	/*
+	 * Opening the catalog may have processed a relcache reset, which drops
+	 * the prewarm cache; so only set it up now.
+	 */
+	if (RelationPrewarmContext == NULL)
+	{
+		HASHCTL		ctl;
+
+		RelationPrewarmContext = AllocSetContextCreate(TopTransactionContext,
+													   "Relcache prewarm",
+													   ALLOCSET_SMALL_MINSIZE,
+													   ALLOCSET_SMALL_INITSIZE,
+													   ALLOCSET_DEFAULT_MAXSIZE);
+
+		MemSet(&ctl, 0, sizeof(ctl));
+		ctl.keysize = sizeof(Oid);
+		ctl.entrysize = sizeof(RelPrewarmCacheEnt);
+		ctl.hash = oid_hash;
+		ctl.hcxt = RelationPrewarmContext;
+		RelationPrewarmCache = hash_create("Relcache prewarm", 64, &ctl,
+										   HASH_ELEM | HASH_FUNCTION | HASH_CONTEXT);
+	}
+
+	while (HeapTupleIsValid(tuple = systable_getnext(scan)))
+	{
+		Oid			relid = HeapTupleGetOid(tuple);
+		RelPrewarmCacheEnt *pentry;
+		bool		found;
+
+		pentry = (RelPrewarmCacheEnt *) hash_search(RelationPrewarmCache,
+													(void *) &relid,
+													HASH_ENTER, &found);
+		if (found)
+			continue;
+
+		oldcxt = MemoryContextSwitchTo(RelationPrewarmContext);
+		pentry->pg_class_tuple = heap_copytuple(tuple);
+		pentry->pg_attribute_tuples = NIL;
+		MemoryContextSwitchTo(oldcxt);
+		nloaded++;
+	}
+
+	systable_endscan(scan);
+	heap_close(rel, AccessShareLock);
+
+	/*
+	 * User attribute rows, as RelationBuildTupleDesc() would read them.  If
+	 * an invalidation for one of the relations was processed since its
+	 * pg_class row was read, its entry is gone and its rows are skipped.
+	 */
+	ScanKeyInit(&skey[0],
+				Anum_pg_attribute_attrelid,
+				BTEqualStrategyNumber, F_OIDEQ,
+				PointerGetDatum(keyarray));
+	skey[0].sk_flags |= SK_SEARCHARRAY;
+	ScanKeyInit(&skey[1],
+				Anum_pg_attribute_attnum,
+				BTGreaterStrategyNumber, F_INT2GT,
+				Int16GetDatum(0));
+
+	rel = heap_open(AttributeRelationId, AccessShareLock);
+	scan = systable_beginscan(rel, AttributeRelidNumIndexId, true,
+							  NULL, 2, skey);
+
+	while (HeapTupleIsValid(tuple = systable_getnext(scan)))
+	{
+		Form_pg_attribute attp = (Form_pg_attribute) GETSTRUCT(tuple);
+		RelPrewarmCacheEnt *pentry;
+
+		pentry = RelationPrewarmLookup(attp->attrelid);
+		if (pentry == NULL)
+			continue;
+
+		oldcxt = MemoryContextSwitchTo(RelationPrewarmContext);
+		pentry->pg_attribute_tuples = lappend(pentry->pg_attribute_tuples,
+											  heap_copytuple(tuple));
+		MemoryContextSwitchTo(oldcxt);
+	}
+
+	systable_endscan(scan);
+	heap_close(rel, AccessShareLock);
+
+	pfree(keyarray);
+	pfree(keys);
+
+	return nloaded;
+}
+
+/*
+ *		RelationPrewarmLookup
+ *
+ *		Find the catalog rows read ahead for a relation, or NULL.
+ */
+static RelPrewarmCacheEnt *
+RelationPrewarmLookup(Oid relid)
+{
+	if (RelationPrewarmCache == NULL)
+		return NULL;
+
+	return (RelPrewarmCacheEnt *) hash_search(RelationPrewarmCache,
+											  (void *) &relid,
+											  HASH_FIND, NULL);
+}
+
+/*
+ *		RelationPrewarmForget
+ *
+ *		Drop the catalog rows read ahead for a relation, if any.  Their
+ *		memory is released at end of transaction.
+ */
+static void
+RelationPrewarmForget(Oid relid)
+{
+	if (RelationPrewarmCache == NULL)
+		return;
+
+	(void) hash_search(RelationPrewarmCache, (void *) &relid,
+					   HASH_REMOVE, NULL);
+}
+
 /*
  *		AllocateRelationDesc
  *
@@ -490,9 +706,11 @@ static void
 RelationBuildTupleDesc(Relation relation)
 {
 	HeapTuple	pg_attribute_tuple;
-	Relation	pg_attribute_desc;
-	SysScanDesc pg_attribute_scan;
+	Relation	pg_attribute_desc = NULL;
+	SysScanDesc pg_attribute_scan = NULL;
 	ScanKeyData skey[2];
+	RelPrewarmCacheEnt *pentry;
+	ListCell   *prewarm_cell = NULL;
 	int			need;
 	TupleConstr *constr;
 	AttrDefault *attrdef = NULL;
@@ -508,40 +726,60 @@ RelationBuildTupleDesc(Relation relation)
 	constr->has_not_null = false;
 
 	/*
-	 * Form a scan key that selects only user attributes (attnum > 0).
-	 * (Eliminating system attribute rows at the index level is lots faster
-	 * than fetching them.)
+	 * If RelationCachePrewarm() has read the attribute rows already, walk
+	 * through those instead of scanning pg_attribute.
 	 */
-	ScanKeyInit(&skey[0],
-				Anum_pg_attribute_attrelid,
-				BTEqualStrategyNumber, F_OIDEQ,
-				ObjectIdGetDatum(RelationGetRelid(relation)));
-	ScanKeyInit(&skey[1],
-				Anum_pg_attribute_attnum,
-				BTGreaterStrategyNumber, F_INT2GT,
-				Int16GetDatum(0));
+	pentry = RelationPrewarmLookup(RelationGetRelid(relation));
+	if (pentry != NULL)
+		prewarm_cell = list_head(pentry->pg_attribute_tuples);
+	else
+	{
+		/*
+		 * Form a scan key that selects only user attributes (attnum > 0).
+		 * (Eliminating system attribute rows at the index level is lots
+		 * faster than fetching them.)
+		 */
+		ScanKeyInit(&skey[0],
+					Anum_pg_attribute_attrelid,
+					BTEqualStrategyNumber, F_OIDEQ,
+					ObjectIdGetDatum(RelationGetRelid(relation)));
+		ScanKeyInit(&skey[1],
+					Anum_pg_attribute_attnum,
+					BTGreaterStrategyNumber, F_INT2GT,
+					Int16GetDatum(0));
 
-	/*
-	 * Open pg_attribute and begin a scan.  Force heap scan if we haven't yet
-	 * built the critical relcache entries (this includes initdb and startup
-	 * without a pg_internal.init file).
-	 */
-	pg_attribute_desc = heap_open(AttributeRelationId, AccessShareLock);
-	pg_attribute_scan = systable_beginscan(pg_attribute_desc,
-										   AttributeRelidNumIndexId,
-										   criticalRelcachesBuilt,
-										   NULL,
-										   2, skey);
+		/*
+		 * Open pg_attribute and begin a scan.  Force heap scan if we haven't
+		 * yet built the critical relcache entries (this includes initdb and
+		 * startup without a pg_internal.init file).
+		 */
+		pg_attribute_desc = heap_open(AttributeRelationId, AccessShareLock);
+		pg_attribute_scan = systable_beginscan(pg_attribute_desc,
+											   AttributeRelidNumIndexId,
+											   criticalRelcachesBuilt,
+											   NULL,
+											   2, skey);
+	}
 
 	/*
 	 * add attribute data to relation->rd_att
 	 */
 	need = relation->rd_rel->relnatts;
 
-	while (HeapTupleIsValid(pg_attribute_tuple = systable_getnext(pg_attribute_scan)))
+	for (;;)
 	{
 		Form_pg_attribute attp;
 
+		if (pentry != NULL)
+		{
+			if (prewarm_cell == NULL)
+				break;
+			pg_attribute_tuple = (HeapTuple) lfirst(prewarm_cell);
+			prewarm_cell = lnext(prewarm_cell);
+		}
+		else if (!HeapTupleIsValid(pg_attribute_tuple = systable_getnext(pg_attribute_scan)))
+			break;
+
 		attp = (Form_pg_attribute) GETSTRUCT(pg_attribute_tuple);
 
 		if (attp->attnum <= 0 ||
@@ -574,10 +812,16 @@ RelationBuildTupleDesc(Relation relation)
 	}
 
 	/*
-	 * end the scan and close the attribute relation
+	 * end the scan and close the attribute relation, or forget the rows read
+	 * ahead, which are not needed anymore
 	 */
-	systable_endscan(pg_attribute_scan);
-	heap_close(pg_attribute_desc, AccessShareLock);
+	if (pentry != NULL)
+		RelationPrewarmForget(RelationGetRelid(relation));
+	else
+	{
+		systable_endscan(pg_attribute_scan);
+		heap_close(pg_attribute_desc, AccessShareLock);
+	}
 
 	if (need != 0)
 		elog(ERROR, "catalog is missing %d attribute(s) for relid %u",
@@ -2450,6 +2694,9 @@ RelationCacheInvalidateEntry(Oid relationId)
 {
 	Relation	relation;
 
+	/* catalog rows read ahead for the relation may be out of date now */
+	RelationPrewarmForget(relationId);
+
 	RelationIdCacheLookup(relationId, relation);
 
 	if (PointerIsValid(relation))
@@ -2499,6 +2746,14 @@ RelationCacheInvalidate(void)
 	List	   *rebuildList = NIL;
 	ListCell   *l;
 
+	/* Discard all catalog rows read ahead by RelationCachePrewarm() */
+	if (RelationPrewarmContext != NULL)
+	{
+		MemoryContextDelete(RelationPrewarmContext);
+		RelationPrewarmContext = NULL;
+		RelationPrewarmCache = NULL;
+	}
+
 	/*
 	 * Reload relation mapping data before starting to reconstruct cache.
 	 */
@@ -2656,6 +2911,10 @@ AtEOXact_RelationCache(bool isCommit)
 	RelIdCacheEnt *idhentry;
 	int			i;
 
+	/* The prewarm cache goes away with TopTransactionContext */
+	RelationPrewarmContext = NULL;
+	RelationPrewarmCache = NULL;
+
 	/*
 	 * Unless the eoxact_list[] overflowed, we only need to examine the rels
 	 * listed in it.  Otherwise fall back on a hash_seq_search scan.
@@ -1236,6 +1236,22 @@ GetSysCacheHashValue(int cacheId,
 	return GetCatCacheHashValue(SysCache[cacheId], key1, key2, key3, key4);
 }
 
+/*
+ * PrewarmSysCache
+ *
+ * Load the entries for the given keys of a single-key OID cache in one go.
+ * See PrewarmCatCache() for details.
+ */
+int
+PrewarmSysCache(int cacheId, int nkeys, Datum *keys)
+{
+	if (cacheId < 0 || cacheId >= SysCacheSize ||
+		!PointerIsValid(SysCache[cacheId]))
+		elog(ERROR, "invalid cache ID: %d", cacheId);
+
+	return PrewarmCatCache(SysCache[cacheId], nkeys, keys);
+}
+
 /*
  * List-search interface
  */
@@ -1315,10 +1315,15 @@ datumstreamread_block_content(DatumStreamRead * acc)
 }
 
 
+/*
+ * Read the header of the next block, but not its content.
+ *
+ * Returns -1 at the end of the segment file, 0 otherwise.  The caller must
+ * follow up with either datumstreamread_block_content, to decompress the
+ * block, or datumstreamread_skip_block, to step over it.
+ */
 int
-datumstreamread_block(DatumStreamRead * acc,
-					  AppendOnlyBlockDirectory *blockDirectory,
-					  int colGroupNo)
+datumstreamread_block_header(DatumStreamRead * acc)
 {
 	bool		readOK = false;
 
@@ -1376,6 +1381,27 @@ datumstreamread_block(DatumStreamRead * acc,
 			 acc->blockFileOffset,
 			 acc->blockRowCount);
 
+	return 0;
+}
+
+/*
+ * Step over the block whose header was just read with
+ * datumstreamread_block_header, without decompressing it.
+ */
+void
+datumstreamread_skip_block(DatumStreamRead * acc)
+{
+	AppendOnlyStorageRead_SkipCurrentBlock(&acc->ao_read);
+}
+
+int
+datumstreamread_block(DatumStreamRead * acc,
+					  AppendOnlyBlockDirectory *blockDirectory,
+					  int colGroupNo)
+{
+	if (datumstreamread_block_header(acc) < 0)
+		return -1;
+
 	datumstreamread_block_content(acc);
 
 	if (blockDirectory)
@@ -1408,6 +1434,14 @@ void
 datumstreamread_find(DatumStreamRead * datumStream,
 					 int32 rowNumInBlock)
 {
+	/* An expanded block can be positioned directly */
+	if (datumStream->blockRead.expanded &&
+		rowNumInBlock < datumStream->blockRead.logical_row_count)
+	{
+		datumStream->blockRead.nth = rowNumInBlock;
+		return;
+	}
+
 	/*
 	 * if reading a tuple that is prior to the tuple that the datum stream
 	 * is pointing to now, reset the datum stream pointers.
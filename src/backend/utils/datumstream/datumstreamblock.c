@@ -131,8 +131,10 @@ DatumStreamBlockRead_ResetOrig(DatumStreamBlockRead * dsr)
 	dsr->physical_datum_index = -1;
 
 	/*
-	 * Reset everything else.
+	 * Reset everything else.  The expansion arrays are kept for the next
+	 * block.
 	 */
+	dsr->expanded = false;
 	dsr->physical_datum_count = 0;
 	dsr->physical_data_size = 0;
 	dsr->logical_row_count = 0;
@@ -403,9 +405,19 @@ void
 DatumStreamBlockRead_Finish(
 							DatumStreamBlockRead * dsr)
 {
-	/* Place holder. */
+	if (dsr->expanded_values != NULL)
+	{
+		pfree(dsr->expanded_values);
+		pfree(dsr->expanded_isnull);
+		dsr->expanded_values = NULL;
+		dsr->expanded_isnull = NULL;
+		dsr->expanded_capacity = 0;
+	}
+	dsr->expanded = false;
 }
 
+static void DatumStreamBlockRead_Expand(DatumStreamBlockRead * dsr);
+
 /*
  * Dense routines.
  */
@@ -654,6 +666,7 @@ DatumStreamBlockRead_GetReadyDense(
 	}
 
 	dsr->buffer_beginp = buffer;
+	dsr->expanded = false;
 
 	/*
 	 * Read header information and setup for reading the datum in the block.
@@ -943,6 +956,199 @@ DatumStreamBlockRead_GetReadyDense(
 		}
 	}
 	dsr->datump = dsr->datum_beginp;
+
+	/*
+	 * Decoding an RLE_TYPE or delta compressed block one item at a time
+	 * costs several bit-map steps and branches per row.  For fixed-length,
+	 * pass-by-value types, decode it all now.
+	 */
+	if (gp_datumstream_expand_blocks &&
+		(dsr->rle_block_was_compressed || dsr->delta_block_was_compressed) &&
+		dsr->typeInfo.byval && dsr->typeInfo.datumlen > 0)
+	{
+		DatumStreamBlockRead_Expand(dsr);
+	}
+}
+
+/*
+ * Reads a physical (stored) fixed-length, pass-by-value item the same way
+ * DatumStreamBlockRead_Get does.
+ */
+static inline Datum
+DatumStreamBlockRead_FetchFixed(uint8 * p, int32 datumlen)
+{
+	if (datumlen == 1)
+		return *(uint8 *) p;
+	else if (datumlen == 2)
+		return *(uint16 *) p;
+	else if (datumlen == 4)
+		return *(uint32 *) p;
+	else
+	{
+		Assert(datumlen == 8);
+		return *(Datum *) p;
+	}
+}
+
+/*
+ * Decode all rows of a Dense block of a fixed-length, pass-by-value type
+ * into dsr->expanded_values and dsr->expanded_isnull, and mark the block
+ * as expanded.
+ *
+ * This follows the same format rules as DatumStreamBlockRead_AdvanceDense,
+ * but with the per-row state in local variables, and with each repeated
+ * item filled in as a run instead of being revisited row by row.  The
+ * repeat counts and deltas are varint-encoded and each delta applies to the
+ * previous value, so the decoding itself is inherently sequential.
+ */
+static void
+DatumStreamBlockRead_Expand(DatumStreamBlockRead * dsr)
+{
+	int32		rowCount = dsr->logical_row_count;
+	int32		datumlen = dsr->typeInfo.datumlen;
+	bool		hasNull = dsr->has_null;
+	bool		rle = dsr->rle_block_was_compressed;
+	bool		delta = dsr->delta_block_was_compressed;
+	DatumStreamBitMapRead nullBitMap;
+	DatumStreamBitMapRead compressBitMap;
+	DatumStreamBitMapRead deltaBitMap;
+	uint8	   *datump = dsr->datum_beginp;
+	uint8	   *repeatcountsp = dsr->rle_repeatcountsp;
+	uint8	   *deltasp = dsr->delta_deltasp;
+	Datum	   *values;
+	bool	   *isnull;
+	Datum		current = 0;
+	int32		nth;
+
+	Assert(dsr->typeInfo.byval && datumlen > 0);
+	Assert(!delta || datumlen == 4 || datumlen == 8);
+
+	if (rowCount > dsr->expanded_capacity)
+	{
+		MemoryContext oldContext = MemoryContextSwitchTo(dsr->memctxt);
+
+		if (dsr->expanded_values != NULL)
+		{
+			pfree(dsr->expanded_values);
+			pfree(dsr->expanded_isnull);
+		}
+		dsr->expanded_values = (Datum *) palloc(rowCount * sizeof(Datum));
+		dsr->expanded_isnull = (bool *) palloc(rowCount * sizeof(bool));
+		dsr->expanded_capacity = rowCount;
+
+		MemoryContextSwitchTo(oldContext);
+	}
+	values = dsr->expanded_values;
+	isnull = dsr->expanded_isnull;
+
+	/*
+	 * Work on copies, so that the positions in dsr stay untouched.  The ones
+	 * not used by this block are not initialized, but they are not read
+	 * either.
+	 */
+	nullBitMap = dsr->null_bitmap;
+	compressBitMap = dsr->rle_compress_bitmap;
+	deltaBitMap = dsr->delta_bitmap;
+
+	nth = 0;
+	while (nth < rowCount)
+	{
+		int32		repeatCount = 0;
+
+		if (hasNull)
+		{
+			DatumStreamBitMapRead_Next(&nullBitMap);
+			if (!DatumStreamBitMapRead_InRange(&nullBitMap))
+				goto corrupt;
+			if (DatumStreamBitMapRead_CurrentIsOn(&nullBitMap))
+			{
+				values[nth] = 0;
+				isnull[nth] = true;
+				nth++;
+				continue;
+			}
+		}
+
+		if (rle)
+		{
+			DatumStreamBitMapRead_Next(&compressBitMap);
+			if (!DatumStreamBitMapRead_InRange(&compressBitMap))
+				goto corrupt;
+			if (DatumStreamBitMapRead_CurrentIsOn(&compressBitMap))
+			{
+				int32		byteLen;
+
+				repeatCount = DatumStreamInt32Compress_Decode(repeatcountsp, &byteLen);
+				repeatcountsp += byteLen;
+				if (repeatCount < 0 || repeatCount >= rowCount - nth)
+					goto corrupt;
+			}
+		}
+
+		if (delta)
+		{
+			DatumStreamBitMapRead_Next(&deltaBitMap);
+			if (!DatumStreamBitMapRead_InRange(&deltaBitMap))
+				goto corrupt;
+		}
+
+		if (delta && DatumStreamBitMapRead_CurrentIsOn(&deltaBitMap))
+		{
+			int64		deltaValue;
+			bool		sign;
+			int32		byteLen;
+
+			deltaValue = DatumStreamInt32CompressReserved3_Decode(deltasp, &byteLen, &sign);
+			deltasp += byteLen;
+
+			if (datumlen == 4)
+			{
+				uint32		v = (uint32) current;
+
+				if (sign)
+					v += deltaValue;
+				else
+					v -= deltaValue;
+				current = v;
+			}
+			else
+			{
+				if (sign)
+					current += deltaValue;
+				else
+					current -= deltaValue;
+			}
+		}
+		else
+		{
+			if (datump + datumlen > dsr->datum_afterp)
+				goto corrupt;
+			current = DatumStreamBlockRead_FetchFixed(datump, datumlen);
+			datump += datumlen;
+		}
+
+		/* The item, plus its repeats for RLE_TYPE */
+		repeatCount++;
+		while (repeatCount-- > 0)
+		{
+			values[nth] = current;
+			isnull[nth] = false;
+			nth++;
+		}
+	}
+
+	dsr->expanded = true;
+	return;
+
+corrupt:
+	ereport(ERROR,
+			(errmsg("Datum stream block %s read found inconsistent RLE_TYPE or delta compression data "
+					"(row %d, logical row count %d)",
+					DatumStreamVersion_String(dsr->datumStreamVersion),
+					nth,
+					rowCount),
+			 errdetail_datumstreamblockread(dsr),
+			 errcontext_datumstreamblockread(dsr)));
 }
 
 static int
@@ -4,6 +4,7 @@
 #include "cmockery.h"
 
 #include "../datumstreamblock.c"
+#include "utils/memutils.h"
 
 /* 
  * Unit test function to test the routines added for
@@ -166,13 +167,149 @@ test__DeltaCompression__Core(void **state)
 	free(dsw);
 }
 
+/*
+ * Write the given values to a Dense block, read them back both one datum at
+ * a time and with the block expanded when it is read, and check that both
+ * return what was written.
+ */
+static void
+check_expand_round_trip(int32 datumlen, Oid typid, bool delta,
+						Datum *values, bool *nulls, int nvalues)
+{
+	DatumStreamTypeInfo typeInfo;
+	DatumStreamBlockWrite dsw;
+	DatumStreamBlockRead dsr;
+	int32		maxDataBlockSize = 32768;
+	uint8	   *buffer;
+	int64		size;
+	int			pass;
+	int			i;
+
+	memset(&typeInfo, 0, sizeof(typeInfo));
+	typeInfo.datumlen = datumlen;
+	typeInfo.typid = typid;
+	typeInfo.byval = true;
+	typeInfo.align = (datumlen == 8 ? 'd' : 'i');
+
+	memset(&dsw, 0, sizeof(dsw));
+	DatumStreamBlockWrite_Init(&dsw, &typeInfo, DatumStreamVersion_Dense_Enhanced,
+							   true, delta,
+							   /* initialMaxDatumPerBlock */ 4096,
+							   /* maxDatumPerBlock */ 4096,
+							   maxDataBlockSize,
+							   NULL, NULL, NULL, NULL);
+	for (i = 0; i < nvalues; i++)
+	{
+		void	   *toFree = NULL;
+
+		assert_true(DatumStreamBlockWrite_Put(&dsw, values[i], nulls[i], &toFree) >= 0);
+	}
+
+	buffer = palloc0(maxDataBlockSize);
+	size = DatumStreamBlockWrite_Block(&dsw, buffer);
+
+	for (pass = 0; pass < 2; pass++)
+	{
+		bool		hadToAdjustRowCount;
+		int32		adjustedRowCount;
+
+		gp_datumstream_expand_blocks = (pass == 1);
+
+		memset(&dsr, 0, sizeof(dsr));
+		DatumStreamBlockRead_Init(&dsr, &typeInfo, DatumStreamVersion_Dense_Enhanced,
+								  true, NULL, NULL, NULL, NULL);
+		DatumStreamBlockRead_GetReady(&dsr, buffer, size, 1, nvalues,
+									  &hadToAdjustRowCount, &adjustedRowCount);
+		assert_int_equal(dsr.expanded, gp_datumstream_expand_blocks);
+
+		for (i = 0; i < nvalues; i++)
+		{
+			Datum		d;
+			bool		isnull;
+
+			assert_int_equal(DatumStreamBlockRead_Advance(&dsr), 1);
+			DatumStreamBlockRead_Get(&dsr, &d, &isnull);
+			assert_int_equal(isnull, nulls[i]);
+			if (isnull)
+				continue;
+			if (datumlen == 4)
+				assert_int_equal(DatumGetInt32(d), DatumGetInt32(values[i]));
+			else
+				assert_true(DatumGetInt64(d) == DatumGetInt64(values[i]));
+		}
+		assert_int_equal(DatumStreamBlockRead_Advance(&dsr), 0);
+
+		DatumStreamBlockRead_Finish(&dsr);
+	}
+
+	gp_datumstream_expand_blocks = true;
+	pfree(buffer);
+	DatumStreamBlockWrite_Finish(&dsw);
+}
+
+#define NVALUES 1000
+
+/*
+ * Runs of repeated values, NULLs, small positive and negative steps and
+ * steps too large to be stored as deltas.
+ */
+static void
+test__DatumStreamBlockRead_Expand__Int4(void **state)
+{
+	Datum		values[NVALUES];
+	bool		nulls[NVALUES];
+	int			i;
+
+	for (i = 0; i < NVALUES; i++)
+	{
+		nulls[i] = (i % 13 == 0);
+		if (i % 100 == 50)
+			values[i] = Int32GetDatum(2000000000);
+		else if (i % 200 < 100)
+			values[i] = Int32GetDatum((i / 7) * 3 - 500);
+		else
+			values[i] = Int32GetDatum(500 - (i / 5) * 11);
+	}
+
+	check_expand_round_trip(4, INT4OID, true, values, nulls, NVALUES);
+	check_expand_round_trip(4, INT4OID, false, values, nulls, NVALUES);
+}
+
+static void
+test__DatumStreamBlockRead_Expand__Int8(void **state)
+{
+	Datum		values[NVALUES];
+	bool		nulls[NVALUES];
+	int			i;
+
+	for (i = 0; i < NVALUES; i++)
+	{
+		nulls[i] = (i % 31 == 0);
+		if (i % 100 == 50)
+			values[i] = Int64GetDatum(INT64CONST(-9000000000000000000));
+		else
+			values[i] = Int64GetDatum((int64) (i / 4) * INT64CONST(1000000007));
+	}
+
+	check_expand_round_trip(8, INT8OID, true, values, nulls, NVALUES);
+
+	/* No NULLs at all, so no NULL bit-map */
+	memset(nulls, 0, sizeof(nulls));
+	check_expand_round_trip(8, INT8OID, true, values, nulls, NVALUES);
+}
+
 int 
 main(int argc, char* argv[]) 
 {
 	cmockery_parse_arguments(argc, argv);
 
 	const UnitTest tests[] = {
-			unit_test(test__DeltaCompression__Core)
+			unit_test(test__DeltaCompression__Core),
+			unit_test(test__DatumStreamBlockRead_Expand__Int4),
+			unit_test(test__DatumStreamBlockRead_Expand__Int8)
 	};
+
+	MemoryContextInit();
+
 	return run_tests(tests);
 }
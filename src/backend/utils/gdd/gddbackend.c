@@ -32,6 +32,7 @@
 #include "utils/gdd.h"
 #include "utils/builtins.h"
 #include "utils/snapmgr.h"
+#include "utils/timestamp.h"
 #include "utils/memutils.h"
 #include "utils/faultinjector.h"
 #include "gdddetector.h"
@@ -63,7 +64,8 @@ typedef struct EdgeSatelliteData
 void GlobalDeadLockDetectorMain(Datum main_arg);
 
 static void GlobalDeadLockDetectorLoop(void);
-static int  doDeadLockCheck(void);
+static int  probeWaitVersion(int64 *version);
+static int  doDeadLockCheck(bool *found);
 static void buildWaitGraph(GddCtx *ctx);
 static void breakDeadLock(GddCtx *ctx);
 static void dumpCancelResult(StringInfo str, List *xids);
@@ -77,6 +79,7 @@ static MemoryContext    oldContext;
 static volatile sig_atomic_t got_SIGHUP = false;
 
 int gp_global_deadlock_detector_period;
+int gp_global_deadlock_detector_probe_interval;
 
 static bool am_global_deadlock_detector = false;
 
@@ -127,10 +130,34 @@ GlobalDeadLockDetectorMain(Datum main_arg)
 	proc_exit(0);
 }
 
+/*
+ * Main loop of the detector.
+ *
+ * Collecting the wait graph means copying the lock table of every segment,
+ * which gets expensive with many concurrent writers.  So unless probing is
+ * disabled, the detector only polls the cheap wait graph version every
+ * gp_global_deadlock_detector_probe_interval, and collects the graph when a
+ * lock wait has lasted deadlock_timeout since the previous check.  While the
+ * version keeps changing the collections back off, up to one per period.
+ *
+ * A cycle found that way may still be a local deadlock whose closing waiter
+ * has not run its own deadlock check yet.  The local detector breaks it
+ * within deadlock_timeout, so the cycle is only broken here if it is still
+ * there when checked again after twice that time.
+ *
+ * The graph is still checked and broken every
+ * gp_global_deadlock_detector_period, as before.  That also covers the rare
+ * cycles closed by a lock changing hands rather than by a new wait.
+ */
 static void
 GlobalDeadLockDetectorLoop(void)
 {
-	int	status;
+	int			status;
+	int64		version = -1;
+	int64		checked_version = -1;
+	TimestampTz	last_check = 0;
+	int			check_gap = 0;
+	bool		confirm = false;
 
 	/* Allocate MemoryContext */
 	gddContext = AllocSetContextCreate(TopMemoryContext,
@@ -142,7 +169,10 @@ GlobalDeadLockDetectorLoop(void)
 	while (true)
 	{
 		int			rc;
-		int			timeout;
+		int			period;
+		long		timeout;
+		bool		found = false;
+		TimestampTz	now;
 
 		if (got_SIGHUP)
 		{
@@ -155,18 +185,71 @@ GlobalDeadLockDetectorLoop(void)
 			continue;
 #endif
 
+		period = Min(gp_global_deadlock_detector_period, INT_MAX / 1000) * 1000;
+
 		StartTransactionCommand();
-		status = doDeadLockCheck();
+		status = STATUS_OK;
+		if (gp_global_deadlock_detector_probe_interval > 0 && !confirm)
+			status = probeWaitVersion(&version);
+
+		now = GetCurrentTimestamp();
+		if (status != STATUS_OK)
+		{
+			/* probe failed, already reported */
+		}
+		else if (confirm ||
+				 gp_global_deadlock_detector_probe_interval == 0 ||
+				 TimestampDifferenceExceeds(last_check, now, period))
+		{
+			status = doDeadLockCheck(NULL);
+			last_check = now;
+			confirm = false;
+		}
+		else if (version == checked_version)
+		{
+			/* nothing new is waiting, react at once to the next wait */
+			check_gap = 0;
+		}
+		else if (TimestampDifferenceExceeds(last_check, now, check_gap))
+		{
+			status = doDeadLockCheck(&found);
+			last_check = now;
+			checked_version = version;
+			if (found)
+				confirm = true;
+			else if (check_gap > period / 2)
+				check_gap = period;
+			else
+				check_gap = Max(check_gap * 2,
+								gp_global_deadlock_detector_probe_interval);
+		}
+
 		if (status == STATUS_OK)
 			CommitTransactionCommand();
 		else
 			AbortCurrentTransaction();
 
-		timeout = got_SIGHUP ? 0 : gp_global_deadlock_detector_period;
+		/*
+		 * After an error retry only after a full period, a segment that is
+		 * down would fail every probe otherwise.
+		 */
+		if (got_SIGHUP)
+			timeout = 0;
+		else if (status != STATUS_OK)
+		{
+			timeout = period;
+			confirm = false;
+		}
+		else if (confirm)
+			timeout = 2L * DeadlockTimeout;
+		else if (gp_global_deadlock_detector_probe_interval > 0)
+			timeout = gp_global_deadlock_detector_probe_interval;
+		else
+			timeout = period;
 
 		rc = WaitLatch(&MyProc->procLatch,
 					   WL_LATCH_SET | WL_TIMEOUT | WL_POSTMASTER_DEATH,
-					   timeout * 1000L);
+					   timeout);
 
 		ResetLatch(&MyProc->procLatch);
 
@@ -178,8 +261,66 @@ GlobalDeadLockDetectorLoop(void)
 	return;
 }
 
+/*
+ * Fetch the version of the cluster wide wait graph, see
+ * gp_dist_wait_version().
+ */
+static int
+probeWaitVersion(int64 *version)
+{
+	volatile int ret_status = RET_STATUS_OK;
+	volatile bool connected = false;
+
+	PG_TRY();
+	{
+		bool		isnull;
+		int			res;
+
+		if (SPI_OK_CONNECT != SPI_connect())
+		{
+			ereport(ERROR,
+					(errcode(ERRCODE_INTERNAL_ERROR),
+					 errmsg("unable to connect to execute internal query")));
+		}
+
+		connected = true;
+
+		PushActiveSnapshot(GetTransactionSnapshot());
+
+		res = SPI_execute("select pg_catalog.gp_dist_wait_version();", true, 1);
+
+		PopActiveSnapshot();
+
+		if (res != SPI_OK_SELECT || SPI_processed != 1)
+			elog(ERROR, "unable to get the version of the wait graph");
+
+		*version = DatumGetInt64(SPI_getbinval(SPI_tuptable->vals[0],
+											   SPI_tuptable->tupdesc,
+											   1, &isnull));
+		Assert(!isnull);
+
+		connected = false;
+		SPI_finish();
+	}
+	PG_CATCH();
+	{
+		if (connected)
+			SPI_finish();
+		EmitErrorReport();
+		FlushErrorState();
+		ret_status = RET_STATUS_ERROR;
+	}
+	PG_END_TRY();
+
+	return ret_status;
+}
+
+/*
+ * Collect and reduce the global wait graph, and break the deadlocks left in
+ * it.  If found is given, only report whether there are any.
+ */
 static int
-doDeadLockCheck(void)
+doDeadLockCheck(bool *found)
 {
 	GddCtx		 *ctx;
 	volatile int ret_status = RET_STATUS_OK;
@@ -194,7 +335,9 @@ doDeadLockCheck(void)
 
 		GddCtxReduce(ctx);
 
-		if (!GddCtxEmpty(ctx))
+		if (found)
+			*found = !GddCtxEmpty(ctx);
+		else if (!GddCtxEmpty(ctx))
 		{
 			StringInfoData wait_graph_str;
 			StringInfoData pglock_str;
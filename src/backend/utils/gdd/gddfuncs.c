@@ -340,3 +340,50 @@ gp_dist_wait_status(PG_FUNCTION_ARGS)
 
 	SRF_RETURN_DONE(funcctx);
 }
+
+/*
+ * gp_dist_wait_version - sum of the wait graph change counters
+ *
+ * Every segment counts the lock waits that lasted deadlock_timeout without
+ * running into a local deadlock, see lockWaitVersion.  The counters only ever grow, so as long as
+ * the sum over the cluster stays the same no wait relation can have been
+ * added.  This is much cheaper than gp_dist_wait_status(), which has to copy
+ * and scan the whole lock table of every segment.
+ */
+Datum
+gp_dist_wait_version(PG_FUNCTION_ARGS)
+{
+	int64		version;
+
+	version = pg_atomic_read_u32(&ProcGlobal->lockWaitVersion);
+
+	if (Gp_role == GP_ROLE_DISPATCH)
+	{
+		CdbPgResults cdb_pgresults = {NULL, 0};
+		int			i;
+
+		CdbDispatchCommand("SELECT pg_catalog.gp_dist_wait_version()",
+						   DF_NONE, &cdb_pgresults);
+
+		if (cdb_pgresults.numResults == 0)
+			elog(ERROR, "gp_dist_wait_version() didn't get back any data from the segDBs");
+
+		for (i = 0; i < cdb_pgresults.numResults; i++)
+		{
+			struct pg_result *pg_result = cdb_pgresults.pg_results[i];
+
+			if (PQresultStatus(pg_result) != PGRES_TUPLES_OK ||
+				PQntuples(pg_result) != 1)
+			{
+				cdbdisp_clearCdbPgResults(&cdb_pgresults);
+				elog(ERROR, "gp_dist_wait_version(): resultStatus not tuples_Ok");
+			}
+
+			version += strtoll(PQgetvalue(pg_result, 0, 0), NULL, 10);
+		}
+
+		cdbdisp_clearCdbPgResults(&cdb_pgresults);
+	}
+
+	PG_RETURN_INT64(version);
+}
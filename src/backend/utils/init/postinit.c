@@ -67,6 +67,7 @@
 #include "utils/fmgroids.h"
 #include "utils/guc.h"
 #include "utils/memutils.h"
+#include "utils/orcamdcache.h"
 #include "utils/pg_locale.h"
 #include "utils/portal.h"
 #include "utils/ps_status.h"
@@ -1147,6 +1148,9 @@ InitPostgres(const char *in_dbname, Oid dboid, const char *username,
 	 */
 	RelationCacheInitializePhase3();
 
+	/* track catalog changes for the shared ORCA metadata cache */
+	OrcaMDCacheInitBackend();
+
 	/* set up ACL framework (so CheckMyDatabase can check permissions) */
 	initialize_acl();
 
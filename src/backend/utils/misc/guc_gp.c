@@ -46,6 +46,8 @@
 #include "utils/builtins.h"
 #include "utils/guc_tables.h"
 #include "utils/inval.h"
+#include "utils/logtape.h"
+#include "utils/memaccounting.h"
 #include "utils/resscheduler.h"
 #include "utils/resgroup.h"
 #include "utils/resource_manager.h"
@@ -92,6 +94,7 @@ static void assign_gp_default_storage_options(const char *newval, void *extra);
 static bool check_pljava_classpath_insecure(bool *newval, void **extra, GucSource source);
 static void assign_pljava_classpath_insecure(bool newval, void *extra);
 static bool check_gp_resource_group_bypass(bool *newval, void **extra, GucSource source);
+static void assign_gp_memory_accounting_batch_size(int newval, void *extra);
 static int guc_array_compare(const void *a, const void *b);
 
 extern struct config_generic *find_option(const char *name, bool create_placeholders, int elevel);
@@ -152,18 +155,22 @@ bool		Debug_datumstream_block_read_check_integrity = false;
 bool		Debug_datumstream_block_write_check_integrity = false;
 bool		Debug_datumstream_read_print_varlena_info = false;
 bool		Debug_datumstream_write_use_small_initial_buffers = false;
+bool		gp_datumstream_expand_blocks = true;
 bool		gp_create_table_random_default_distribution = true;
 bool		gp_allow_non_uniform_partitioning_ddl = true;
 bool		gp_print_create_gang_time = false;
 bool		gp_enable_exchange_default_partition = false;
 int			dtx_phase2_retry_count = 0;
+int			gp_dtx_group_commit_delay = 0;
 bool		gp_log_suboverflow_statement = false;
 bool        gp_use_synchronize_seqscans_catalog_vacuum_full = false;
+bool		gp_catcache_prewarm = false;
 
 bool		log_dispatch_stats = false;
 bool		gp_keep_partition_children_locks = false;
 
 int			explain_memory_verbosity = 0;
+int			gp_memory_accounting_batch_size = 0;
 char	   *memory_profiler_run_id = "none";
 char	   *memory_profiler_dataset_id = "none";
 char	   *memory_profiler_query_id = "none";
@@ -309,7 +316,10 @@ int			optimizer_minidump;
 int			optimizer_cost_model;
 bool		optimizer_metadata_caching;
 int			optimizer_mdcache_size;
+int			optimizer_plan_cache_size;
+int			optimizer_mdcache_shared_size;
 bool		optimizer_use_gpdb_allocators;
+bool		optimizer_use_arena_memory_pools;
 
 /* Optimizer debugging GUCs */
 bool		optimizer_print_query;
@@ -408,6 +418,8 @@ int			optimizer_cte_inlining_bound;
 int			optimizer_push_group_by_below_setop_threshold;
 int			optimizer_xform_bind_threshold;
 int			optimizer_skew_factor;
+int			optimizer_search_time_budget;
+int			optimizer_search_memory_budget;
 bool		optimizer_force_multistage_agg;
 bool		optimizer_force_three_stage_scalar_dqa;
 bool		optimizer_force_expanded_distinct_aggs;
@@ -469,6 +481,8 @@ bool		gp_external_enable_filter_pushdown = true;
 /* Executor */
 bool		gp_enable_mk_sort = true;
 bool		gp_enable_motion_mk_sort = true;
+bool		gp_enable_ao_count_pushdown = true;
+bool		gp_enable_aocs_late_materialization = true;
 
 /* Enable GDD */
 bool		gp_enable_global_deadlock_detector = false;
@@ -935,6 +949,30 @@ struct config_bool ConfigureNamesBool_gp[] =
 		NULL, NULL, NULL
 	},
 
+	{
+		{"gp_enable_ao_count_pushdown", PGC_USERSET, QUERY_TUNING_METHOD,
+			gettext_noop("Compute count(*) over append-optimized tables from segment file metadata."),
+			gettext_noop("An ungrouped count(*) directly over a sequential scan without "
+						 "filter takes the row count from pg_aoseg and the visibility map "
+						 "instead of reading the table.")
+		},
+		&gp_enable_ao_count_pushdown,
+		true,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"gp_enable_aocs_late_materialization", PGC_USERSET, QUERY_TUNING_METHOD,
+			gettext_noop("Read the remaining columns of a column-oriented scan only for rows that pass the filter."),
+			gettext_noop("The columns used by the filter of a sequential scan on an "
+						 "append-optimized column-oriented table are read first; "
+						 "the other columns are decompressed only for qualifying rows.")
+		},
+		&gp_enable_aocs_late_materialization,
+		true,
+		NULL, NULL, NULL
+	},
+
 	{
 		{"gp_gang_creation_retry_non_recovery", PGC_USERSET, QUERY_TUNING_METHOD,
 		 gettext_noop("Retry gang creation if non-recovery failures are encountered during dispatch."),
@@ -1189,6 +1227,16 @@ struct config_bool ConfigureNamesBool_gp[] =
 		check_gp_workfile_compression, NULL, NULL
 	},
 
+	{
+		{"gp_logtape_prefetch", PGC_USERSET, RESOURCES_DISK,
+			gettext_noop("Prefetch the next block of each logical tape while reading spilled sort runs."),
+			NULL
+		},
+		&gp_logtape_prefetch,
+		true,
+		NULL, NULL, NULL
+	},
+
 	{
 		{"gp_reraise_signal", PGC_SUSET, DEVELOPER_OPTIONS,
 			gettext_noop("Do we attempt to dump core when a serious problem occurs."),
@@ -1604,6 +1652,19 @@ struct config_bool ConfigureNamesBool_gp[] =
 		NULL, NULL, NULL
 	},
 
+	{
+		{"gp_datumstream_expand_blocks", PGC_USERSET, DEVELOPER_OPTIONS,
+			gettext_noop("Decode whole RLE_TYPE or delta compressed column blocks at once."),
+			gettext_noop("Fixed-length, pass-by-value columns of such blocks are "
+						 "decoded into an array when the block is read, instead of "
+						 "one value at a time as the scan advances."),
+			GUC_NO_SHOW_ALL | GUC_NOT_IN_SAMPLE
+		},
+		&gp_datumstream_expand_blocks,
+		true,
+		NULL, NULL, NULL
+	},
+
 	{
 		{"debug_datumstream_read_print_varlena_info", PGC_SUSET, DEVELOPER_OPTIONS,
 			gettext_noop("Print datum stream read varlena information."),
@@ -3038,6 +3099,17 @@ struct config_bool ConfigureNamesBool_gp[] =
 		NULL, NULL, NULL
 	},
 
+	{
+		{"optimizer_use_arena_memory_pools", PGC_POSTMASTER, RESOURCES_MEM,
+			gettext_noop("Enable ORCA to allocate its objects from arenas in GPDB memory contexts."),
+			gettext_noop("Only takes effect when optimizer_use_gpdb_allocators is on."),
+			GUC_NO_SHOW_ALL | GUC_NOT_IN_SAMPLE
+		},
+		&optimizer_use_arena_memory_pools,
+		false,
+		NULL, NULL, NULL
+	},
+
 	{
 		{"vmem_process_interrupt", PGC_USERSET, DEVELOPER_OPTIONS,
 			gettext_noop("Checks for interrupts before reserving VMEM"),
@@ -3384,6 +3456,17 @@ struct config_bool ConfigureNamesBool_gp[] =
 		 NULL, NULL, NULL
 	},
 
+	{
+		{"gp_catcache_prewarm", PGC_USERSET, QUERY_TUNING_OTHER,
+			gettext_noop("Loads the catalog entries a dispatched plan needs in one scan per catalog."),
+			gettext_noop("Only affects segments executing a dispatched plan."),
+			GUC_NOT_IN_SAMPLE
+		},
+		&gp_catcache_prewarm,
+		false,
+		NULL, NULL, NULL
+	},
+
 	{
 		{"gp_use_synchronize_seqscans_catalog_vacuum_full", PGC_USERSET, COMPAT_OPTIONS_PREVIOUS,
 		 gettext_noop("Enable synchronized sequential scans for VACUUM FULL for catalog tables. Given by default now syncscans are not used for VACUUM FULL on catalog tables, this GUC will help in-case wish to fix pre-existing catalog state"),
@@ -4521,6 +4604,18 @@ struct config_int ConfigureNamesInt_gp[] =
 		120, 5, INT_MAX, NULL, NULL
 	},
 
+	{
+		{"gp_global_deadlock_detector_probe_interval", PGC_SIGHUP, LOCK_MANAGEMENT,
+			gettext_noop("Sets how often global deadlock detector backend checks for new lock waits."),
+			gettext_noop("The wait graph is collected and checked once a lock wait has lasted "
+						 "deadlock_timeout since the previous check. Zero disables the probes "
+						 "and checks the wait graph every gp_global_deadlock_detector_period."),
+			GUC_UNIT_MS
+		},
+		&gp_global_deadlock_detector_probe_interval,
+		5000, 0, INT_MAX, NULL, NULL
+	},
+
 	{
 		{"optimizer_plan_id", PGC_USERSET, DEVELOPER_OPTIONS,
 			gettext_noop("Choose a plan alternative"),
@@ -4609,6 +4704,28 @@ struct config_int ConfigureNamesInt_gp[] =
             NULL, NULL, NULL
     },
 
+	{
+		{"optimizer_search_time_budget", PGC_USERSET, QUERY_TUNING_METHOD,
+			gettext_noop("Sets the time after which GPORCA stops searching and returns the best plan found so far."),
+			gettext_noop("A value of 0 turns off the limit."),
+			GUC_UNIT_MS
+		},
+		&optimizer_search_time_budget,
+		0, 0, INT_MAX,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"optimizer_search_memory_budget", PGC_USERSET, QUERY_TUNING_METHOD,
+			gettext_noop("Sets the optimizer memory after which GPORCA stops searching and returns the best plan found so far."),
+			gettext_noop("A value of 0 turns off the limit."),
+			GUC_UNIT_KB
+		},
+		&optimizer_search_memory_budget,
+		0, 0, MAX_KILOBYTES,
+		NULL, NULL, NULL
+	},
+
 	{
 		{"optimizer_join_order_threshold", PGC_USERSET, QUERY_TUNING_METHOD,
 			gettext_noop("Maximum number of join children to use dynamic programming based join ordering algorithm."),
@@ -4652,6 +4769,27 @@ struct config_int ConfigureNamesInt_gp[] =
 		NULL, NULL, NULL
 	},
 
+	{
+		{"optimizer_mdcache_shared_size", PGC_POSTMASTER, RESOURCES_MEM,
+			gettext_noop("Sets the size of the MDCache shared by all sessions on the master."),
+			gettext_noop("Zero disables the shared MDCache."),
+			GUC_UNIT_KB
+		},
+		&optimizer_mdcache_shared_size,
+		0, 0, MAX_KILOBYTES,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"optimizer_plan_cache_size", PGC_USERSET, QUERY_TUNING_OTHER,
+			gettext_noop("Sets the number of GPORCA plans cached for reuse by later executions of the same query."),
+			gettext_noop("Zero disables the plan cache.")
+		},
+		&optimizer_plan_cache_size,
+		0, 0, INT_MAX,
+		NULL, NULL, NULL
+	},
+
 	{
 		{"memory_profiler_dataset_size", PGC_USERSET, DEVELOPER_OPTIONS,
 			gettext_noop("Set the size in GB"),
@@ -4662,6 +4800,17 @@ struct config_int ConfigureNamesInt_gp[] =
 		0, 0, INT_MAX,
 		NULL, NULL, NULL
 	},
+
+	{
+		{"gp_memory_accounting_batch_size", PGC_USERSET, RESOURCES_MEM,
+			gettext_noop("Sets the amount of allocations gathered before they are charged to their memory account."),
+			gettext_noop("Zero charges every allocation to its memory account right away."),
+			GUC_UNIT_KB
+		},
+		&gp_memory_accounting_batch_size,
+		0, 0, 1024 * 1024,
+		NULL, assign_gp_memory_accounting_batch_size, NULL
+	},
 	{
 		{"repl_catchup_within_range", PGC_SUSET, REPLICATION_STANDBY,
 			gettext_noop("Sets the maximum number of xlog segments allowed to lag"
@@ -4745,6 +4894,19 @@ struct config_int ConfigureNamesInt_gp[] =
 		NULL, NULL, NULL
 	},
 
+	{
+		{"gp_dtx_group_commit_delay", PGC_SUSET, WAL_SETTINGS,
+			gettext_noop("Sets the delay in microseconds before flushing WAL while other "
+						 "distributed transactions are in two-phase commit."),
+			gettext_noop("A value of 0 turns off the delay."),
+			GUC_NOT_IN_SAMPLE
+			/* we have no microseconds designation, so can't supply units here */
+		},
+		&gp_dtx_group_commit_delay,
+		0, 0, 100000,
+		NULL, NULL, NULL
+	},
+
 	{
 		/* Can't be set in postgresql.conf */
 		{"gp_server_version_num", PGC_INTERNAL, PRESET_OPTIONS,
@@ -5534,6 +5696,16 @@ check_pljava_classpath_insecure(bool *newval, void **extra, GucSource source)
 	return true;
 }
 
+/*
+ * Allocations batched so far are charged to their account before the
+ * batching mode changes.
+ */
+static void
+assign_gp_memory_accounting_batch_size(int newval, void *extra)
+{
+	MemoryAccounting_FlushBatch(MEMORY_OWNER_TYPE_Undefined);
+}
+
 static void
 assign_pljava_classpath_insecure(bool newval, void *extra)
 {
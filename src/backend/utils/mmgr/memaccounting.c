@@ -229,6 +229,14 @@ uint64 MemoryAccountingOutstandingBalance = 0;
  */
 uint64 MemoryAccountingPeakBalance = 0;
 
+/*
+ * Account whose allocations and frees are currently being batched, and the
+ * amounts not yet charged to it (see MemoryAccounting_FlushBatch)
+ */
+MemoryAccountIdType MemoryAccountingBatchAccountId = MEMORY_OWNER_TYPE_Undefined;
+uint64 MemoryAccountingBatchAllocated = 0;
+uint64 MemoryAccountingBatchFreed = 0;
+
 /******************************************/
 /********** Public interface **************/
 
@@ -250,8 +258,14 @@ MemoryAccounting_Reset()
 		/* No one should create child context under MemoryAccountMemoryContext */
 		Assert(MemoryAccountMemoryContext->firstchild == NULL);
 
+		/* The batched account may not survive the reset */
+		MemoryAccounting_FlushBatch(MEMORY_OWNER_TYPE_Undefined);
+
 		AdvanceMemoryAccountingGeneration();
 
+		/* Frees during the reset may have started a new batch */
+		MemoryAccounting_FlushBatch(MEMORY_OWNER_TYPE_Undefined);
+
 		/* Outstanding balance will come from either the rollover or the shared chunk header account */
 		Assert((RolloverMemoryAccount->allocated - RolloverMemoryAccount->freed) +
 				(SharedChunkHeadersMemoryAccount->allocated - SharedChunkHeadersMemoryAccount->freed) +
@@ -273,8 +287,11 @@ MemoryAccounting_Reset()
 uint64
 MemoryAccounting_DeclareDone()
 {
-	MemoryAccount *currentAccount = MemoryAccounting_ConvertIdToAccount(ActiveMemoryAccountId);
+	MemoryAccount *currentAccount;
 	uint64 relinquished = 0;
+
+	MemoryAccounting_FlushBatch(MEMORY_OWNER_TYPE_Undefined);
+	currentAccount = MemoryAccounting_ConvertIdToAccount(ActiveMemoryAccountId);
 	if (currentAccount->maxLimit > 0 && currentAccount->maxLimit > currentAccount->allocated)
 	{
 		relinquished = currentAccount->maxLimit - currentAccount->allocated;
@@ -297,6 +314,47 @@ MemoryAccounting_RequestQuotaIncrease()
 	return result;
 }
 
+/*
+ * MemoryAccounting_FlushBatch
+ *		Charges the batched allocations and frees to their account, and starts
+ *		batching for another account.
+ *
+ *		With gp_memory_accounting_batch_size set, the allocator does not update
+ *		the account of every chunk. Instead, allocations and frees of one account
+ *		are summed up here, and only applied when a batch worth of memory went
+ *		through, when another account allocates, or when the balances are read.
+ *		The pending allocations are applied before the pending frees, so the
+ *		peaks seen are never below the exact ones, and at most one batch above.
+ *
+ * newBatchAccountId: the account to batch from now on
+ */
+void
+MemoryAccounting_FlushBatch(MemoryAccountIdType newBatchAccountId)
+{
+	if (MemoryAccountingBatchAllocated > 0 || MemoryAccountingBatchFreed > 0)
+	{
+		MemoryAccount *memoryAccount =
+			MemoryAccounting_ConvertIdToAccount(MemoryAccountingBatchAccountId);
+
+		memoryAccount->allocated += MemoryAccountingBatchAllocated;
+		memoryAccount->peak = Max(memoryAccount->peak,
+								  memoryAccount->allocated - memoryAccount->freed);
+		memoryAccount->freed += MemoryAccountingBatchFreed;
+
+		Assert(memoryAccount->allocated >= memoryAccount->freed);
+
+		MemoryAccountingOutstandingBalance += MemoryAccountingBatchAllocated;
+		MemoryAccountingPeakBalance = Max(MemoryAccountingPeakBalance,
+										  MemoryAccountingOutstandingBalance);
+		MemoryAccountingOutstandingBalance -= MemoryAccountingBatchFreed;
+
+		MemoryAccountingBatchAllocated = 0;
+		MemoryAccountingBatchFreed = 0;
+	}
+
+	MemoryAccountingBatchAccountId = newBatchAccountId;
+}
+
 /*
  * MemoryAccounting_CreateAccount
  *		Public method to create a memory account. We use this to force outside
@@ -378,6 +436,7 @@ MemoryAccounting_SizeOfAccountInBytes()
 uint64
 MemoryAccounting_GetAccountPeakBalance(MemoryAccountIdType memoryAccountId)
 {
+	MemoryAccounting_FlushBatch(MEMORY_OWNER_TYPE_Undefined);
 	return MemoryAccounting_ConvertIdToAccount(memoryAccountId)->peak;
 }
 
@@ -390,7 +449,10 @@ MemoryAccounting_GetAccountPeakBalance(MemoryAccountIdType memoryAccountId)
 uint64
 MemoryAccounting_GetAccountCurrentBalance(MemoryAccountIdType memoryAccountId)
 {
-	MemoryAccount *account = MemoryAccounting_ConvertIdToAccount(memoryAccountId);
+	MemoryAccount *account;
+
+	MemoryAccounting_FlushBatch(MEMORY_OWNER_TYPE_Undefined);
+	account = MemoryAccounting_ConvertIdToAccount(memoryAccountId);
 	return account->allocated - account->freed;
 }
 
@@ -413,6 +475,7 @@ MemoryAccounting_GetBalance(MemoryAccount* memoryAccount)
 uint64
 MemoryAccounting_GetGlobalPeak()
 {
+	MemoryAccounting_FlushBatch(MEMORY_OWNER_TYPE_Undefined);
 	return MemoryAccountingPeakBalance;
 }
 
@@ -425,6 +488,8 @@ MemoryAccounting_Serialize(StringInfoData *buffer)
 {
 	START_MEMORY_ACCOUNT(MEMORY_OWNER_TYPE_MemAccount);
 	{
+		MemoryAccounting_FlushBatch(MEMORY_OWNER_TYPE_Undefined);
+
 		/* Ignore undefined account */
 		for (MemoryAccountIdType longIdx = MEMORY_OWNER_TYPE_LogicalRoot; longIdx <= MEMORY_OWNER_TYPE_END_LONG_LIVING; longIdx++)
 		{
@@ -489,6 +554,8 @@ MemoryAccounting_SaveToFile(int currentSliceId)
 			memory_profiler_dataset_size, statement_mem, gp_session_id, GetCurrentStatementStartTimestamp(),
 			currentSliceId, GpIdentity.segindex);
 
+	MemoryAccounting_FlushBatch(MEMORY_OWNER_TYPE_Undefined);
+
 	MemoryAccountTree *tree = ConvertMemoryAccountArrayToTree(&longLivingMemoryAccountArray[MEMORY_OWNER_TYPE_Undefined],
 			shortLivingMemoryAccountArray->allAccounts, shortLivingMemoryAccountArray->accountCount);
 	PsuedoAccountsToCSV(&memBuf, prefix.data);
@@ -518,6 +585,8 @@ MemoryAccounting_SaveToLog()
 	int64 max_vmem_reserved = VmemTracker_GetMaxReservedVmemBytes();
 	int64 vmem_reserved = VmemTracker_GetReservedVmemBytes();
 
+	MemoryAccounting_FlushBatch(MEMORY_OWNER_TYPE_Undefined);
+
 	/* Write the header for the subsequent lines of memory usage information */
 	write_stderr("memory: account_name, account_id, parent_account_id, quota, peak, allocated, freed, current\n");
 
@@ -638,6 +638,82 @@ test__MemoryAccounting_GetAccountCurrentBalance__ResetPeakBalance(void **state)
 	MemoryAccounting_SwitchAccount(oldAccountId);
 }
 
+/*
+ * Tests if allocations and frees batched by gp_memory_accounting_batch_size
+ * are charged to their account once the balance is read
+ */
+static void
+test__MemoryAccounting_FlushBatch__ChargesBatchedBalance(void **state)
+{
+	MemoryAccountIdType newAccountId = MemoryAccounting_CreateAccount(0, MEMORY_OWNER_TYPE_Exec_Hash);
+	MemoryAccountIdType oldAccountId = MemoryAccounting_SwitchAccount(newAccountId);
+	MemoryAccount *memoryAccount = MemoryAccounting_ConvertIdToAccount(newAccountId);
+
+	gp_memory_accounting_batch_size = 1024;
+
+	void *testAlloc = palloc(NEW_ALLOC_SIZE);
+
+	/* The allocation is only pending */
+	assert_true(MemoryAccountingBatchAccountId == newAccountId);
+	assert_true(memoryAccount->allocated == 0);
+
+	/* Reading the balance charges it */
+	assert_true(MemoryAccounting_GetAccountCurrentBalance(newAccountId) == NEW_ALLOC_SIZE + ALLOC_CHUNKHDRSZ);
+	assert_true(MemoryAccountingBatchAccountId == MEMORY_OWNER_TYPE_Undefined);
+	assert_true(MemoryAccountingBatchAllocated == 0);
+
+	pfree(testAlloc);
+	assert_true(MemoryAccounting_GetAccountCurrentBalance(newAccountId) == 0);
+
+	/* An allocation freed within the same batch still shows in the peak */
+	memoryAccount->peak = 0;
+	testAlloc = palloc(NEW_ALLOC_SIZE);
+	pfree(testAlloc);
+	assert_true(MemoryAccountingBatchFreed == NEW_ALLOC_SIZE + ALLOC_CHUNKHDRSZ);
+	assert_true(MemoryAccounting_GetAccountPeakBalance(newAccountId) >= NEW_ALLOC_SIZE + ALLOC_CHUNKHDRSZ);
+	assert_true(MemoryAccounting_GetAccountCurrentBalance(newAccountId) == 0);
+
+	gp_memory_accounting_batch_size = 0;
+	MemoryAccounting_SwitchAccount(oldAccountId);
+}
+
+/*
+ * Tests if a free from another account, while allocations are batched, does
+ * not hide the pending allocations from the global peak
+ */
+static void
+test__MemoryAccounting_FlushBatch__FreeFromOtherAccount(void **state)
+{
+	MemoryAccountIdType firstAccountId = MemoryAccounting_CreateAccount(0, MEMORY_OWNER_TYPE_Exec_Hash);
+	MemoryAccountIdType secondAccountId = MemoryAccounting_CreateAccount(0, MEMORY_OWNER_TYPE_Exec_Sort);
+	MemoryAccountIdType oldAccountId = MemoryAccounting_SwitchAccount(firstAccountId);
+	MemoryAccount *firstAccount = MemoryAccounting_ConvertIdToAccount(firstAccountId);
+
+	void *firstAlloc = palloc(NEW_ALLOC_SIZE);
+
+	gp_memory_accounting_batch_size = 1024;
+	MemoryAccounting_SwitchAccount(secondAccountId);
+	MemoryAccounting_ResetPeakBalance();
+
+	uint64 expectedPeak = MemoryAccountingOutstandingBalance + NEW_ALLOC_SIZE + ALLOC_CHUNKHDRSZ;
+
+	void *secondAlloc = palloc(NEW_ALLOC_SIZE);
+	assert_true(MemoryAccountingBatchAccountId == secondAccountId);
+	assert_true(MemoryAccountingBatchAllocated == NEW_ALLOC_SIZE + ALLOC_CHUNKHDRSZ);
+
+	/* Both allocations were held at once, before this free */
+	pfree(firstAlloc);
+	assert_true(MemoryAccountingBatchAllocated == 0);
+	assert_true(firstAccount->allocated == firstAccount->freed);
+	assert_true(MemoryAccounting_GetGlobalPeak() >= expectedPeak);
+
+	pfree(secondAlloc);
+	assert_true(MemoryAccounting_GetAccountCurrentBalance(secondAccountId) == 0);
+
+	gp_memory_accounting_batch_size = 0;
+	MemoryAccounting_SwitchAccount(oldAccountId);
+}
+
 /*
  * Tests if the MemoryAccounting_Reset() resets the high water
  * mark (i.e., peak balance)
@@ -1342,6 +1418,8 @@ main(int argc, char* argv[])
 		unit_test_setup_teardown(test__MemoryAccounting_CombinedAccountArrayToExplain__Validate, SetupMemoryDataStructures, TeardownMemoryDataStructures),
 		unit_test_setup_teardown(test__ConvertIdToUniversalArrayIndex__Validate, SetupMemoryDataStructures, TeardownMemoryDataStructures),
 		unit_test_setup_teardown(test__MemoryAccounting_GetAccountCurrentBalance__ResetPeakBalance, SetupMemoryDataStructures, TeardownMemoryDataStructures),
+		unit_test_setup_teardown(test__MemoryAccounting_FlushBatch__ChargesBatchedBalance, SetupMemoryDataStructures, TeardownMemoryDataStructures),
+		unit_test_setup_teardown(test__MemoryAccounting_FlushBatch__FreeFromOtherAccount, SetupMemoryDataStructures, TeardownMemoryDataStructures),
 	};
 
 	return run_tests(tests);
@@ -60,6 +60,7 @@
 #include "storage/proc.h"
 #include "storage/procarray.h"
 #include "storage/procsignal.h"
+#include "storage/spin.h"
 #include "utils/builtins.h"
 #include "utils/memutils.h"
 #include "utils/ps_status.h"
@@ -82,6 +83,14 @@
 #define RESGROUP_BYPASS_MODE_MEMORY_LIMIT_ON_QD	30
 #define RESGROUP_BYPASS_MODE_MEMORY_LIMIT_ON_QE	10
 
+/*
+ * Disk bandwidth throttling: a group may run this far ahead of its
+ * io_read_limit / io_write_limit before it has to wait, and waits are done
+ * in steps of at most RESGROUP_IO_SLEEP_USECS to stay responsive to cancel.
+ */
+#define RESGROUP_IO_BURST_USECS	(100 * 1000)
+#define RESGROUP_IO_SLEEP_USECS	(10 * 1000)
+
 /*
  * GUC variables.
  */
@@ -229,6 +238,18 @@ struct ResGroupData
 	bool		lockedForDrop;  /* true if resource group is dropped but not committed yet */
 
 	ResGroupCaps	caps;		/* capabilities of this group */
+
+	/*
+	 * Disk bandwidth of the group, see ResGroupThrottleIO().  ioReadTat and
+	 * ioWriteTat are the times at which the bytes charged so far would have
+	 * been transferred at io_read_limit / io_write_limit, they are protected
+	 * by ioLock.
+	 */
+	slock_t		ioLock;
+	TimestampTz	ioReadTat;
+	TimestampTz	ioWriteTat;
+	pg_atomic_uint64	ioReadBytes;	/* bytes read since group creation */
+	pg_atomic_uint64	ioWriteBytes;	/* bytes written since group creation */
 };
 
 struct ResGroupControl
@@ -293,6 +314,9 @@ static ResGroupData *bypassedGroup = NULL;
 /* a fake slot used in bypass mode */
 static ResGroupSlotData bypassedSlot;
 
+/* io throttling delay we could not sleep off yet, in microseconds */
+static int64 ioPendingDelay = 0;
+
 /* static functions */
 
 static bool groupApplyMemCaps(ResGroupData *group);
@@ -335,6 +359,7 @@ static void initSlot(ResGroupSlotData *slot, ResGroupData *group,
 					 int32 slotMemQuota);
 static void selfAttachResGroup(ResGroupData *group, ResGroupSlotData *slot);
 static void selfDetachResGroup(ResGroupData *group, ResGroupSlotData *slot);
+static bool selfDetachResGroupIfNotLast(ResGroupData *group, ResGroupSlotData *slot);
 static bool slotpoolInit(void);
 static ResGroupSlotData *slotpoolAllocSlot(void);
 static void slotpoolFreeSlot(ResGroupSlotData *slot);
@@ -918,6 +943,11 @@ ResGroupAlterOnCommit(const ResourceGroupCallbackContext *callbackCtx)
 				ResGroupOps_SetCpuSet(callbackCtx->groupid, cpuset);
 			}
 		}
+		else if (callbackCtx->limittype == RESGROUP_LIMIT_TYPE_IO_READ_LIMIT ||
+				 callbackCtx->limittype == RESGROUP_LIMIT_TYPE_IO_WRITE_LIMIT)
+		{
+			/* the new limits are picked up by ResGroupThrottleIO() */
+		}
 		else if (callbackCtx->limittype != RESGROUP_LIMIT_TYPE_MEMORY_SPILL_RATIO)
 		{
 			Assert(pResGroupControl->totalChunks > 0);
@@ -1262,6 +1292,96 @@ ResGroupReleaseMemory(int32 memoryChunks)
 	groupDecMemUsage(group, slot, memoryChunks);
 }
 
+/*
+ * Charge a disk read or write of 'bytes' to my resource group, and sleep if
+ * the group has used up its io_read_limit / io_write_limit.
+ *
+ * The limit is enforced as a token bucket, kept as the time at which the
+ * group would have finished all its io at the configured rate.  A process
+ * that pushes that time more than RESGROUP_IO_BURST_USECS ahead of now waits
+ * for the difference.
+ *
+ * Some io happens while we hold an lwlock or are in a critical section, e.g.
+ * reading a page into shared buffers or writing out a dirty victim buffer.
+ * Sleeping there would stall everybody waiting for the lock, so such io is
+ * only charged, and the delay is served by the next call at a safe point.
+ * Callers may pass 0 bytes just to serve that delay.
+ */
+void
+ResGroupThrottleIO(Size bytes, bool isWrite)
+{
+	ResGroupData	*group;
+	ResGroupCap		limit;
+	int64			delay = 0;
+
+	if (!IsResGroupActivated())
+		return;
+
+	if (bypassedGroup)
+		group = bypassedGroup;
+	else if (selfIsAssigned())
+		group = self->group;
+	else
+		return;
+
+	if (isWrite)
+		pg_atomic_fetch_add_u64(&group->ioWriteBytes, bytes);
+	else
+		pg_atomic_fetch_add_u64(&group->ioReadBytes, bytes);
+
+	limit = isWrite ? group->caps.ioWriteLimit : group->caps.ioReadLimit;
+	if (limit > RESGROUP_UNLIMITED_IO_LIMIT && bytes > 0)
+	{
+		TimestampTz		now = GetCurrentTimestamp();
+		TimestampTz		*tat = isWrite ? &group->ioWriteTat : &group->ioReadTat;
+
+		SpinLockAcquire(&group->ioLock);
+		*tat = Max(*tat, now) +
+			(int64) bytes * USECS_PER_SEC / ((int64) limit << BITS_IN_MB);
+		delay = *tat - now - RESGROUP_IO_BURST_USECS;
+		SpinLockRelease(&group->ioLock);
+	}
+
+	delay = Max(delay, ioPendingDelay);
+	if (delay <= 0)
+		return;
+
+	if (InterruptHoldoffCount > 0 || CritSectionCount > 0)
+	{
+		ioPendingDelay = delay;
+		return;
+	}
+
+	ioPendingDelay = 0;
+	while (delay > 0)
+	{
+		long	usecs = Min(delay, RESGROUP_IO_SLEEP_USECS);
+
+		CHECK_FOR_INTERRUPTS();
+		pg_usleep(usecs);
+		delay -= usecs;
+	}
+}
+
+/*
+ * Get the total number of bytes read and written by a resource group.
+ */
+void
+ResGroupGetIOUsage(Oid groupId, uint64 *readBytes, uint64 *writeBytes)
+{
+	ResGroupData	*group;
+
+	Assert(IsResGroupActivated());
+
+	LWLockAcquire(ResGroupLock, LW_SHARED);
+
+	group = groupHashFind(groupId, true);
+	*readBytes = pg_atomic_read_u64(&group->ioReadBytes);
+	*writeBytes = pg_atomic_read_u64(&group->ioWriteBytes);
+
+	LWLockRelease(ResGroupLock);
+}
+
 int64
 ResourceGroupGetQueryMemoryLimit(void)
 {
@@ -1351,6 +1471,11 @@ createGroup(Oid groupId, const ResGroupCaps *caps)
 	group->groupMemOps = NULL;
 	memset(&group->totalQueuedTime, 0, sizeof(group->totalQueuedTime));
 	group->lockedForDrop = false;
+	SpinLockInit(&group->ioLock);
+	group->ioReadTat = 0;
+	group->ioWriteTat = 0;
+	pg_atomic_init_u64(&group->ioReadBytes, 0);
+	pg_atomic_init_u64(&group->ioWriteBytes, 0);
 
 	group->memQuotaGranted = 0;
 	group->memSharedGranted = 0;
@@ -1594,6 +1719,40 @@ selfDetachResGroup(ResGroupData *group, ResGroupSlotData *slot)
 	selfUnsetGroup();
 }
 
+/*
+ * Detach a process from a slot, unless it is the last one attached.
+ *
+ * Only the last process has to put the slot back, which needs ResGroupLock
+ * in exclusive mode; the others only update atomic counters and can do so
+ * while holding it in shared mode.  Slots are only released with the lock
+ * held exclusively, so nProcs can't reach 0 behind our back.
+ *
+ * Return true if detached, or false if this is the last process and nothing
+ * has been changed.
+ */
+static bool
+selfDetachResGroupIfNotLast(ResGroupData *group, ResGroupSlotData *slot)
+{
+	uint32		nProcs;
+
+	Assert(LWLockHeldByMe(ResGroupLock));
+
+	nProcs = pg_atomic_read_u32((pg_atomic_uint32 *) &slot->nProcs);
+	while (nProcs > 1)
+	{
+		if (pg_atomic_compare_exchange_u32((pg_atomic_uint32 *) &slot->nProcs,
+										   &nProcs, nProcs - 1))
+		{
+			groupDecMemUsage(group, slot, self->memUsage);
+			selfUnsetSlot();
+			selfUnsetGroup();
+			return true;
+		}
+	}
+
+	return false;
+}
+
 /*
  * Initialize the members of a slot
  */
@@ -2757,11 +2916,28 @@ UnassignResGroup(void)
 	if (self->memUsage > 10)
 		LOG_RESGROUP_DEBUG(LOG, "idle proc memory usage: %d", self->memUsage);
 
-	LWLockAcquire(ResGroupLock, LW_EXCLUSIVE);
-
 	group = self->group;
 	slot = self->slot;
 
+	/*
+	 * A query with several slices has several QEs attached to the same slot
+	 * on a segment, try to leave without the exclusive lock first.
+	 */
+	LWLockAcquire(ResGroupLock, LW_SHARED);
+	if (selfDetachResGroupIfNotLast(group, slot))
+	{
+		LWLockRelease(ResGroupLock);
+
+		if (Gp_role == GP_ROLE_DISPATCH)
+			SIMPLE_FAULT_INJECTOR("unassign_resgroup_end_qd");
+
+		pgstat_report_resgroup(0, InvalidOid);
+		return;
+	}
+	LWLockRelease(ResGroupLock);
+
+	LWLockAcquire(ResGroupLock, LW_EXCLUSIVE);
+
 	/* Sub proc memory accounting info from group and slot */
 	selfDetachResGroup(group, slot);
 
@@ -2863,7 +3039,21 @@ SwitchResGroupOnSegment(const char *buf, int len)
 		return;
 	}
 
-	LWLockAcquire(ResGroupLock, LW_EXCLUSIVE);
+	/*
+	 * Attaching to a slot that another QE of this session already holds
+	 * only updates atomic counters, and the slot can't be released while we
+	 * hold ResGroupLock in shared mode.  Only the first QE of the session
+	 * needs the exclusive lock to allocate the slot.
+	 */
+	LWLockAcquire(ResGroupLock, LW_SHARED);
+	slot = sessionGetSlot();
+	if (slot == NULL)
+	{
+		LWLockRelease(ResGroupLock);
+		LWLockAcquire(ResGroupLock, LW_EXCLUSIVE);
+		slot = sessionGetSlot();
+	}
+
 	group = groupHashFind(newGroupId, true);
 	Assert(group != NULL);
 
@@ -2873,7 +3063,6 @@ SwitchResGroupOnSegment(const char *buf, int len)
 	self->caps = caps;
 
 	/* Init slot */
-	slot = sessionGetSlot();
 	if (slot != NULL)
 	{
 		Assert(slotIsInUse(slot));
@@ -2882,6 +3071,7 @@ SwitchResGroupOnSegment(const char *buf, int len)
 	else
 	{
 		/* This is the first QE of this session, allocate a slot from slot pool */
+		Assert(LWLockHeldExclusiveByMe(ResGroupLock));
 		slot = slotpoolAllocSlot();
 		Assert(!slotIsInUse(slot));
 		sessionSetSlot(slot);
@@ -3962,13 +4152,16 @@ static void
 resgroupDumpCaps(StringInfo str, ResGroupCap *caps)
 {
 	int i;
+	const ResGroupCaps *groupCaps = (const ResGroupCaps *) caps;
+
 	appendStringInfo(str, "\"caps\":[");
-	for (i = 1; i < RESGROUP_LIMIT_TYPE_COUNT; i++)
-	{
-		appendStringInfo(str, "{\"%d\":%d}", i, caps[i]);
-		if (i < RESGROUP_LIMIT_TYPE_COUNT - 1)
-			appendStringInfo(str, ",");
-	}
+	for (i = 1; i <= RESGROUP_LIMIT_TYPE_CPUSET; i++)
+		appendStringInfo(str, "{\"%d\":%d},", i, caps[i]);
+
+	/* the caps after cpuset can't be accessed via index */
+	appendStringInfo(str, "{\"%d\":%d},{\"%d\":%d}",
+					 RESGROUP_LIMIT_TYPE_IO_READ_LIMIT, groupCaps->ioReadLimit,
+					 RESGROUP_LIMIT_TYPE_IO_WRITE_LIMIT, groupCaps->ioWriteLimit);
 	appendStringInfo(str, "]");
 }
 
@@ -34,6 +34,7 @@ typedef struct ResGroupStat
 
 	StringInfo cpuUsage;
 	StringInfo memUsage;
+	StringInfo ioUsage;
 } ResGroupStat;
 
 typedef struct ResGroupStatCtx
@@ -45,6 +46,9 @@ typedef struct ResGroupStatCtx
 static void calcCpuUsage(StringInfoData *str,
 						 int64 usageBegin, TimestampTz timestampBegin,
 						 int64 usageEnd, TimestampTz timestampEnd);
+static void calcIOUsage(StringInfoData *str, Oid groupId,
+						uint64 readBegin, uint64 writeBegin,
+						TimestampTz timestampBegin);
 static void getResUsage(ResGroupStatCtx *ctx, Oid inGroupId);
 static void dumpResGroupInfo(StringInfo str);
 
@@ -69,6 +73,31 @@ calcCpuUsage(StringInfoData *str,
 					 ResGroupOps_ConvertCpuUsageToPercent(usage, duration));
 }
 
+/*
+ * Append the disk bandwidth used by a group since timestampBegin, in MB/s.
+ */
+static void
+calcIOUsage(StringInfoData *str, Oid groupId,
+			uint64 readBegin, uint64 writeBegin, TimestampTz timestampBegin)
+{
+	uint64		readEnd;
+	uint64		writeEnd;
+	long		secs;
+	int			usecs;
+	double		duration;
+
+	ResGroupGetIOUsage(groupId, &readEnd, &writeEnd);
+
+	TimestampDifference(timestampBegin, GetCurrentTimestamp(), &secs, &usecs);
+
+	duration = Max(secs + usecs / 1000000.0, 0.000001) * (1 << 20);
+
+	appendStringInfo(str, "\"%d\":{\"read\":%.2f, \"write\":%.2f}",
+					 GpIdentity.segindex,
+					 (readEnd - readBegin) / duration,
+					 (writeEnd - writeBegin) / duration);
+}
+
 /*
  * Get resource usage.
  *
@@ -77,16 +106,20 @@ calcCpuUsage(StringInfoData *str,
  *
  * On QE this function only collect the resource usage on itself.
  *
- * Memory & cpu usage are returned in JSON format.
+ * Memory, cpu & io usage are returned in JSON format.
  */
 static void
 getResUsage(ResGroupStatCtx *ctx, Oid inGroupId)
 {
 	int64 *usages;
+	uint64 *ioReads;
+	uint64 *ioWrites;
 	TimestampTz *timestamps;
 	int i, j;
 
 	usages = palloc(sizeof(*usages) * ctx->nGroups);
+	ioReads = palloc(sizeof(*ioReads) * ctx->nGroups);
+	ioWrites = palloc(sizeof(*ioWrites) * ctx->nGroups);
 	timestamps = palloc(sizeof(*timestamps) * ctx->nGroups);
 
 	for (j = 0; j < ctx->nGroups; j++)
@@ -95,6 +128,7 @@ getResUsage(ResGroupStatCtx *ctx, Oid inGroupId)
 		Oid groupId = DatumGetObjectId(row->groupId);
 
 		usages[j] = ResGroupOps_GetCpuUsage(groupId);
+		ResGroupGetIOUsage(groupId, &ioReads[j], &ioWrites[j]);
 		timestamps[j] = GetCurrentTimestamp();
 	}
 
@@ -105,7 +139,7 @@ getResUsage(ResGroupStatCtx *ctx, Oid inGroupId)
 
 		initStringInfo(&buffer);
 		appendStringInfo(&buffer,
-						 "SELECT groupid, cpu_usage, memory_usage "
+						 "SELECT groupid, cpu_usage, memory_usage, io_usage "
 						 "FROM pg_resgroup_get_status(%u)",
 						 inGroupId);
 
@@ -150,6 +184,10 @@ getResUsage(ResGroupStatCtx *ctx, Oid inGroupId)
 					calcCpuUsage(row->cpuUsage, usages[j], timestamps[j],
 								 ResGroupOps_GetCpuUsage(groupId),
 								 GetCurrentTimestamp());
+
+					appendStringInfo(row->ioUsage, "{");
+					calcIOUsage(row->ioUsage, groupId,
+								ioReads[j], ioWrites[j], timestamps[j]);
 				}
 
 				result = PQgetvalue(pg_result, j, 1);
@@ -158,10 +196,14 @@ getResUsage(ResGroupStatCtx *ctx, Oid inGroupId)
 				result = PQgetvalue(pg_result, j, 2);
 				appendStringInfo(row->memUsage, ", %s", result);
 
+				result = PQgetvalue(pg_result, j, 3);
+				appendStringInfo(row->ioUsage, ", %s", result);
+
 				if (i == cdb_pgresults.numResults - 1)
 				{
 					appendStringInfoChar(row->cpuUsage, '}');
 					appendStringInfoChar(row->memUsage, '}');
+					appendStringInfoChar(row->ioUsage, '}');
 				}
 			}
 		}
@@ -184,6 +226,9 @@ getResUsage(ResGroupStatCtx *ctx, Oid inGroupId)
 			calcCpuUsage(row->cpuUsage, usages[j], timestamps[j],
 						 ResGroupOps_GetCpuUsage(groupId),
 						 GetCurrentTimestamp());
+
+			calcIOUsage(row->ioUsage, groupId,
+						ioReads[j], ioWrites[j], timestamps[j]);
 		}
 	}
 }
@@ -210,7 +255,7 @@ pg_resgroup_get_status(PG_FUNCTION_ARGS)
 	{
 		MemoryContext oldcontext;
 		TupleDesc	tupdesc;
-		int			nattr = 8;
+		int			nattr = 9;
 
 		funcctx = SRF_FIRSTCALL_INIT();
 
@@ -225,6 +270,7 @@ pg_resgroup_get_status(PG_FUNCTION_ARGS)
 		TupleDescInitEntry(tupdesc, (AttrNumber) 6, "total_queue_duration", INTERVALOID, -1, 0);
 		TupleDescInitEntry(tupdesc, (AttrNumber) 7, "cpu_usage", JSONOID, -1, 0);
 		TupleDescInitEntry(tupdesc, (AttrNumber) 8, "memory_usage", JSONOID, -1, 0);
+		TupleDescInitEntry(tupdesc, (AttrNumber) 9, "io_usage", JSONOID, -1, 0);
 
 		funcctx->tuple_desc = BlessTupleDesc(tupdesc);
 
@@ -261,6 +307,7 @@ pg_resgroup_get_status(PG_FUNCTION_ARGS)
 					Assert(funcctx->max_calls < MaxResourceGroups);
 					ctx->groups[funcctx->max_calls].cpuUsage = makeStringInfo();
 					ctx->groups[funcctx->max_calls].memUsage = makeStringInfo();
+					ctx->groups[funcctx->max_calls].ioUsage = makeStringInfo();
 					ctx->groups[funcctx->max_calls++].groupId = oid;
 
 					if (inGroupId != InvalidOid)
@@ -288,8 +335,8 @@ pg_resgroup_get_status(PG_FUNCTION_ARGS)
 	if (funcctx->call_cntr < funcctx->max_calls)
 	{
 		/* for each row */
-		Datum		values[8];
-		bool		nulls[8];
+		Datum		values[9];
+		bool		nulls[9];
 		HeapTuple	tuple;
 		Oid			groupId;
 		char		statVal[MAXDATELEN + 1];
@@ -321,6 +368,7 @@ pg_resgroup_get_status(PG_FUNCTION_ARGS)
 
 		values[6] = CStringGetTextDatum(row->cpuUsage->data);
 		values[7] = CStringGetTextDatum(row->memUsage->data);
+		values[8] = CStringGetTextDatum(row->ioUsage->data);
 
 		tuple = heap_form_tuple(funcctx->tuple_desc, values, nulls);
 
@@ -355,6 +355,59 @@ test__shouldBypassQuery__with_only_catalog(void **state)
 	assert_true(shouldBypassQuery("select * from pg_catalog.pg_rules"));
 }
 
+static void
+test__selfDetachResGroupIfNotLast(void **state)
+{
+	ResGroupData group;
+	ResGroupSlotData slot;
+
+	MemSet(&group, 0, sizeof(group));
+	MemSet(&slot, 0, sizeof(slot));
+
+	group.groupId = 100;
+	group.memUsage = 20;
+	slot.group = &group;
+	slot.groupId = group.groupId;
+	slot.memQuota = 30;
+	slot.memUsage = 20;
+	slot.nProcs = 2;
+
+	self->groupId = group.groupId;
+	self->group = &group;
+	self->slot = &slot;
+	self->memUsage = 8;
+
+#ifdef USE_ASSERT_CHECKING
+	expect_value_count(LWLockHeldByMe, l, ResGroupLock, 2);
+	will_return_count(LWLockHeldByMe, true, 2);
+#endif
+
+	/* another process is still attached, so we can leave */
+	assert_true(selfDetachResGroupIfNotLast(&group, &slot));
+	assert_int_equal(slot.nProcs, 1);
+	assert_int_equal(slot.memUsage, 12);
+	assert_int_equal(group.memUsage, 12);
+	assert_true(self->slot == NULL);
+	assert_true(self->groupId == InvalidOid);
+
+	/* the last process must release the slot, nothing is changed */
+	self->groupId = group.groupId;
+	self->group = &group;
+	self->slot = &slot;
+	self->memUsage = 12;
+
+	assert_false(selfDetachResGroupIfNotLast(&group, &slot));
+	assert_int_equal(slot.nProcs, 1);
+	assert_int_equal(slot.memUsage, 12);
+	assert_int_equal(group.memUsage, 12);
+	assert_true(self->slot == &slot);
+
+	self->groupId = InvalidOid;
+	self->group = NULL;
+	self->slot = NULL;
+	self->memUsage = 0;
+}
+
 int
 main(int argc, char *argv[])
 {
@@ -379,6 +432,7 @@ main(int argc, char *argv[])
 			test_with_setup_and_teardown(test__shouldBypassQuery__forced_bypass_mode),
 			test_with_setup_and_teardown(test__shouldBypassQuery__message_context_is_null),
 			test_with_setup_and_teardown(test__shouldBypassQuery__with_only_catalog),
+			unit_test(test__selfDetachResGroupIfNotLast),
 	};
 
 	MemoryContextInit();
@@ -702,7 +702,9 @@ dumpResGroups(PGconn *conn)
 			i_memory_shared_quota,
 			i_memory_spill_ratio,
 			i_memory_auditor,
-			i_cpuset;
+			i_cpuset,
+			i_io_read_limit,
+			i_io_write_limit;
 
 	printfPQExpBuffer(buf, "SELECT g.rsgname AS groupname, "
 					  "t1.value AS concurrency, "
@@ -711,7 +713,9 @@ dumpResGroups(PGconn *conn)
 					  "t4.value AS memory_shared_quota, "
 					  "t5.value AS memory_spill_ratio, "
 					  "t6.value AS memory_auditor, "
-					  "t7.value AS cpuset "
+					  "t7.value AS cpuset, "
+					  "t8.value AS io_read_limit, "
+					  "t9.value AS io_write_limit "
 					  "FROM pg_resgroup g "
 					  "     JOIN pg_resgroupcapability t1 ON g.oid = t1.resgroupid AND t1.reslimittype = 1 "
 					  "     JOIN pg_resgroupcapability t2 ON g.oid = t2.resgroupid AND t2.reslimittype = 2 "
@@ -719,7 +723,9 @@ dumpResGroups(PGconn *conn)
 					  "     JOIN pg_resgroupcapability t4 ON g.oid = t4.resgroupid AND t4.reslimittype = 4 "
 					  "     JOIN pg_resgroupcapability t5 ON g.oid = t5.resgroupid AND t5.reslimittype = 5 "
 					  "LEFT JOIN pg_resgroupcapability t6 ON g.oid = t6.resgroupid AND t6.reslimittype = 6 "
-					  "LEFT JOIN pg_resgroupcapability t7 ON g.oid = t7.resgroupid AND t7.reslimittype = 7;");
+					  "LEFT JOIN pg_resgroupcapability t7 ON g.oid = t7.resgroupid AND t7.reslimittype = 7 "
+					  "LEFT JOIN pg_resgroupcapability t8 ON g.oid = t8.resgroupid AND t8.reslimittype = 8 "
+					  "LEFT JOIN pg_resgroupcapability t9 ON g.oid = t9.resgroupid AND t9.reslimittype = 9;");
 
 	res = executeQuery(conn, buf->data);
 
@@ -731,6 +737,8 @@ dumpResGroups(PGconn *conn)
 	i_memory_spill_ratio = PQfnumber(res, "memory_spill_ratio");
 	i_memory_auditor = PQfnumber(res, "memory_auditor");
 	i_cpuset = PQfnumber(res, "cpuset");
+	i_io_read_limit = PQfnumber(res, "io_read_limit");
+	i_io_write_limit = PQfnumber(res, "io_write_limit");
 
 	if (PQntuples(res) > 0)
 		fprintf(OPF, "--\n-- Resource Group\n--\n\n");
@@ -754,6 +762,8 @@ dumpResGroups(PGconn *conn)
 		const char *memory_spill_ratio;
 		const char *memory_auditor;
 		const char *cpuset;
+		const char *io_read_limit;
+		const char *io_write_limit;
 
 		groupname = PQgetvalue(res, i, i_groupname);
 		cpu_rate_limit = PQgetvalue(res, i, i_cpu_rate_limit);
@@ -763,6 +773,8 @@ dumpResGroups(PGconn *conn)
 		memory_spill_ratio = PQgetvalue(res, i, i_memory_spill_ratio);
 		memory_auditor = PQgetvalue(res, i, i_memory_auditor);
 		cpuset = PQgetvalue(res, i, i_cpuset);
+		io_read_limit = PQgetvalue(res, i, i_io_read_limit);
+		io_write_limit = PQgetvalue(res, i, i_io_write_limit);
 
 		resetPQExpBuffer(buf);
 
@@ -830,6 +842,17 @@ dumpResGroups(PGconn *conn)
 							  memory_spill_ratio, memory_auditor_name);
 		}
 
+		/*
+		 * The io limits are only stored once they are set, an empty or 0
+		 * value means unlimited.
+		 */
+		if (atoi(io_read_limit) > 0)
+			appendPQExpBuffer(buf, "ALTER RESOURCE GROUP %s SET io_read_limit %s;\n",
+							  fmtId(groupname), io_read_limit);
+		if (atoi(io_write_limit) > 0)
+			appendPQExpBuffer(buf, "ALTER RESOURCE GROUP %s SET io_write_limit %s;\n",
+							  fmtId(groupname), io_write_limit);
+
 		fprintf(OPF, "%s", buf->data);
 	}
 
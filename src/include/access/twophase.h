@@ -65,6 +65,7 @@ extern void PostPrepare_Twophase(void);
 
 extern PGPROC *TwoPhaseGetDummyProc(TransactionId xid);
 extern BackendId TwoPhaseGetDummyBackendId(TransactionId xid);
+extern bool MinimumPreparedXacts(int min);
 
 extern GlobalTransaction MarkAsPreparing(TransactionId xid, 
 				LocalDistribXactData *localDistribXactRef,
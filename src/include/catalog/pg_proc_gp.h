@@ -155,14 +155,18 @@ DESCR("terminate a server process");
 DATA(insert OID = 6065 ( pg_resgroup_get_status_kv  PGNSP PGUID 12 1 1000 0 0 f f f f f t v 1 0 2249 "25" "{25,26,25,25}" "{i,o,o,o}" "{prop_in,rsgid,prop,value}" _null_ pg_resgroup_get_status_kv _null_ _null_ _null_ n a ));
 DESCR("statistics: information about resource groups in key-value style");
 
-/* pg_resgroup_get_status(IN groupid oid, OUT groupid oid, OUT num_running int4, OUT num_queueing int4, OUT num_queued int4, OUT num_executed int4, OUT total_queue_duration interval, OUT cpu_usage json, OUT memory_usage json) => SETOF pg_catalog.record */
-DATA(insert OID = 6066 ( pg_resgroup_get_status  PGNSP PGUID 12 1 1000 0 0 f f f f f t v 1 0 2249 "26" "{26,26,23,23,23,23,1186,114,114}" "{i,o,o,o,o,o,o,o,o}" "{groupid,groupid,num_running,num_queueing,num_queued,num_executed,total_queue_duration,cpu_usage,memory_usage}" _null_ pg_resgroup_get_status _null_ _null_ _null_ n a ));
+/* pg_resgroup_get_status(IN groupid oid, OUT groupid oid, OUT num_running int4, OUT num_queueing int4, OUT num_queued int4, OUT num_executed int4, OUT total_queue_duration interval, OUT cpu_usage json, OUT memory_usage json, OUT io_usage json) => SETOF pg_catalog.record */
+DATA(insert OID = 6066 ( pg_resgroup_get_status  PGNSP PGUID 12 1 1000 0 0 f f f f f t v 1 0 2249 "26" "{26,26,23,23,23,23,1186,114,114,114}" "{i,o,o,o,o,o,o,o,o,o}" "{groupid,groupid,num_running,num_queueing,num_queued,num_executed,total_queue_duration,cpu_usage,memory_usage,io_usage}" _null_ pg_resgroup_get_status _null_ _null_ _null_ n a ));
 DESCR("statistics: information about resource groups");
 
 /* gp_dist_wait_status(OUT segid int4, OUT waiter_dxid xid, OUT holder_dxid xid, OUT holdTillEndXact bool, OUT waiter_lpid int4, OUT holder_lpid int4, OUT waiter_lockmode text, OUT waiter_locktype text, OUT waiter_sessionid int4, OUT holder_sessionid int4) => SETOF pg_catalog.record */
 DATA(insert OID = 6036 ( gp_dist_wait_status  PGNSP PGUID 12 1 1000 0 0 f f f f f t v 0 0 2249 "" "{23,28,28,16,23,23,25,25,23,23}" "{o,o,o,o,o,o,o,o,o,o}" "{segid,waiter_dxid,holder_dxid,holdTillEndXact,waiter_lpid,holder_lpid,waiter_lockmode,waiter_locktype,waiter_sessionid,holder_sessionid}" _null_ gp_dist_wait_status _null_ _null_ _null_ n a ));
 DESCR("waiting relation information");
 
+/* gp_dist_wait_version() => int8 */
+DATA(insert OID = 6053 ( gp_dist_wait_version  PGNSP PGUID 12 1 0 0 0 f f f f f f v 0 0 20 "" _null_ _null_ _null_ _null_ gp_dist_wait_version _null_ _null_ _null_ n a ));
+DESCR("change counter of the waiting relations");
+
 /* pg_resqueue_status() => SETOF record */
 DATA(insert OID = 6030 ( pg_resqueue_status  PGNSP PGUID 12 1 1000 0 0 f f f f t t v 0 0 2249 "" _null_ _null_ _null_ _null_ pg_resqueue_status _null_ _null_ _null_ n a ));
 DESCR("Return resource queue information");
@@ -74,6 +74,8 @@ typedef enum ResGroupLimitType
 	RESGROUP_LIMIT_TYPE_MEMORY_SPILL_RATIO,
 	RESGROUP_LIMIT_TYPE_MEMORY_AUDITOR,
 	RESGROUP_LIMIT_TYPE_CPUSET,
+	RESGROUP_LIMIT_TYPE_IO_READ_LIMIT,
+	RESGROUP_LIMIT_TYPE_IO_WRITE_LIMIT,
 
 	RESGROUP_LIMIT_TYPE_COUNT,
 } ResGroupLimitType;
@@ -72,6 +72,35 @@ typedef struct AOCSInsertDescData
 
 typedef AOCSInsertDescData *AOCSInsertDesc;
 
+/*
+ * Callback evaluating the scan qual for late materialization.  It is called
+ * with a slot in which only the qual columns hold valid values, and returns
+ * true if the row passes.
+ */
+typedef bool (*AOCSScanQualCallback) (TupleTableSlot *slot, void *arg);
+
+/*
+ * Read position of a column whose values are only materialized for rows
+ * that passed the qual.  Rows are counted from 0 at the start of the
+ * segment file, which unlike the stored row numbers is also valid for
+ * pre-4.0 blocks.
+ */
+typedef enum AOCSLazyColumnState
+{
+	AOCSLazyColumn_NoBlock,		/* no block read yet in this segment file */
+	AOCSLazyColumn_Header,		/* block header read, content not read */
+	AOCSLazyColumn_Content		/* block content decompressed */
+} AOCSLazyColumnState;
+
+typedef struct AOCSLazyColumn
+{
+	int			attno;
+	AOCSLazyColumnState state;
+	int64		blockFirstRow;	/* first row of the current block */
+	int			blockRowCount;	/* number of rows in the current block */
+	int64		nextRow;		/* row the next advance will return */
+} AOCSLazyColumn;
+
 /*
  * used for scan of append only relations using BufferedRead and VarBlocks
  */
@@ -127,6 +156,18 @@ typedef struct AOCSScanDescData
 
 	AppendOnlyVisimap visibilityMap;
 
+	/*
+	 * Late materialization, see aocs_set_late_materialization.  If lm_qual
+	 * is set, only the columns in lm_qual_atts are read for every row, and
+	 * the columns in lm_lazy are read only for rows that pass lm_qual.
+	 */
+	AOCSScanQualCallback lm_qual;
+	void	   *lm_qual_arg;
+	int		   *lm_qual_atts;
+	int			num_lm_qual_atts;
+	AOCSLazyColumn *lm_lazy;
+	int			num_lm_lazy;
+
 }	AOCSScanDescData;
 
 typedef AOCSScanDescData *AOCSScanDesc;
@@ -214,6 +255,9 @@ extern void aocs_rescan(AOCSScanDesc scan);
 extern void aocs_endscan(AOCSScanDesc scan);
 
 extern bool aocs_getnext(AOCSScanDesc scan, ScanDirection direction, TupleTableSlot *slot);
+extern int64 aocs_count_visible(AOCSScanDesc scan);
+extern bool aocs_set_late_materialization(AOCSScanDesc scan, bool *qualproj,
+							  AOCSScanQualCallback qual, void *arg);
 extern AOCSInsertDesc aocs_insert_init(Relation rel, int segno, bool update_mode);
 extern Oid aocs_insert_values(AOCSInsertDesc idesc, Datum *d, bool *null, AOTupleId *aoTupleId);
 static inline Oid aocs_insert(AOCSInsertDesc idesc, TupleTableSlot *slot)
@@ -342,6 +342,7 @@ extern void appendonly_endscan(AppendOnlyScanDesc scan);
 extern bool appendonly_getnext(AppendOnlyScanDesc scan,
 							   ScanDirection direction,
 							   TupleTableSlot *slot);
+extern int64 appendonly_count_visible(AppendOnlyScanDesc scan);
 extern AppendOnlyFetchDesc appendonly_fetch_init(
 	Relation 	relation,
 	Snapshot    snapshot,
@@ -124,6 +124,9 @@ all_partition_relids(PartitionNode *pn);
 extern Node *
 get_relation_part_constraints(Oid rootOid, List **defaultLevels);
 
+extern List *
+get_relation_part_default_levels(Oid rootOid);
+
 extern Node *
 get_leaf_part_constraints(Oid partoid, List **defaultLevels);
 
@@ -774,6 +774,12 @@ extern bool gp_enable_sort_distinct;
 extern bool gp_enable_mk_sort;
 extern bool gp_enable_motion_mk_sort;
 
+/* Answer count(*) over append-optimized scans from segment file metadata */
+extern bool gp_enable_ao_count_pushdown;
+
+/* Read the other columns of an AOCS scan only for rows that pass the qual */
+extern bool gp_enable_aocs_late_materialization;
+
 /* Alter table add column inherits storage setting from the table */
 extern bool gp_add_column_inherits_table_setting;
 
@@ -109,6 +109,31 @@ typedef struct HashSkewBucket
 #define SKEW_WORK_MEM_PERCENT  2
 #define SKEW_MIN_OUTER_FRACTION  0.01
 
+/*
+ * To reduce palloc overhead, the HashJoinTuples for the current batch are
+ * packed in 32kB buffers instead of pallocing each tuple individually.
+ * Tuples are never freed one at a time; when nbatch is increased, the tuples
+ * that stay in memory are copied into fresh chunks and the old chunks are
+ * released as a whole.
+ */
+typedef struct HashMemoryChunkData
+{
+	int			ntuples;		/* number of tuples stored in this chunk */
+	size_t		maxlen;			/* size of the buffer holding the tuples */
+	size_t		used;			/* number of buffer bytes already used */
+
+	struct HashMemoryChunkData *next;	/* pointer to the next chunk (linked
+										 * list) */
+
+	char		data[FLEXIBLE_ARRAY_MEMBER];	/* buffer allocated at the end */
+}	HashMemoryChunkData;
+
+typedef struct HashMemoryChunkData *HashMemoryChunk;
+
+#define HASH_CHUNK_HEADER_SIZE	offsetof(HashMemoryChunkData, data)
+#define HASH_CHUNK_SIZE			(32 * 1024L)
+#define HASH_CHUNK_THRESHOLD	(HASH_CHUNK_SIZE / 4)
+
 
 /* Statistics collection workareas for EXPLAIN ANALYZE */
 typedef struct HashJoinBatchStats
@@ -203,6 +228,8 @@ typedef struct HashJoinTableData
 	MemoryContext batchCxt;		/* context for this-batch-only storage */
 	MemoryContext bfCxt;		/* CDB */ /* context for temp buf file */
 
+	HashMemoryChunk chunks;		/* tuples of the current batch, in batchCxt */
+
     HashJoinTableStats *stats;  /* statistics workarea for EXPLAIN ANALYZE */
     bool		eagerlyReleased; /* Has this hash-table been eagerly released? */
 
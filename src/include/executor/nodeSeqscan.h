@@ -23,4 +23,7 @@ extern TupleTableSlot *ExecSeqScan(SeqScanState *node);
 extern void ExecEndSeqScan(SeqScanState *node);
 extern void ExecReScanSeqScan(SeqScanState *node);
 
+extern bool ExecSeqScanCanCountTuples(SeqScanState *node);
+extern int64 ExecSeqScanCountTuples(SeqScanState *node);
+
 #endif   /* NODESEQSCAN_H */
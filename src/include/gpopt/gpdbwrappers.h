@@ -24,6 +24,7 @@ extern "C" {
 #include "storage/lmgr.h"
 #include "utils/faultinjector.h"
 #include "utils/lsyscache.h"
+#include "utils/orcamdcache.h"
 }
 
 #include "gpos/types.h"
@@ -252,6 +253,9 @@ List *GetCheckConstraintOids(Oid rel_oid);
 // part constraint expression tree
 Node *GetRelationPartContraints(Oid rel_oid, List **default_levels);
 
+// levels of a partitioned table that have a default partition
+List *GetRelationPartDefaultLevels(Oid rel_oid);
+
 // part constraint expression tree for a leaf partition
 Node *GetLeafPartContraints(Oid rel_oid, List **default_levels);
 
@@ -687,6 +691,15 @@ gpos::ULONG CountLeafPartTables(Oid oidRelation);
 // table has been changed?)
 bool MDCacheNeedsReset(void);
 
+// look up the DXL of a metadata object in the MDCache shared by all backends
+char *SharedMDCacheLookup(int mdtype, const char *mdid, Size *len,
+						  OrcaMDCacheVersion *version);
+
+// add the DXL of a metadata object to the shared MDCache
+void SharedMDCacheInsert(int mdtype, const char *mdid,
+						 const OrcaMDCacheVersion *version, const char *data,
+						 Size len);
+
 // returns true if a query cancel is requested in GPDB
 bool IsAbortRequested(void);
 
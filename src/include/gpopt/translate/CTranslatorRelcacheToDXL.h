@@ -165,9 +165,6 @@ private:
 			is_allowed_for_PS  // output: is this an increasing function (lossy cast) allowed for partition selection
 	);
 
-	// check and fall back for unsupported relations
-	static void CheckUnsupportedRelation(OID rel_oid);
-
 	// get type name from the relcache
 	static CMDName *GetTypeName(CMemoryPool *mp, IMDId *mdid);
 
@@ -371,6 +368,9 @@ public:
 	static IMDRelation *RetrieveRel(CMemoryPool *mp, CMDAccessor *md_accessor,
 									IMDId *mdid);
 
+	// check and fall back for unsupported relations
+	static void CheckUnsupportedRelation(OID rel_oid);
+
 	// add system columns (oid, tid, xmin, etc) in table descriptors
 	static void AddSystemColumns(CMemoryPool *mp, CMDColumnArray *mdcol_array,
 								 Relation rel, BOOL is_ao_table);
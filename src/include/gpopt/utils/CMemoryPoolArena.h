@@ -0,0 +1,152 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2019 Pivotal, Inc.
+//
+//	@filename:
+//		CMemoryPoolArena.h
+//
+//	@doc:
+//		CMemoryPool implementation that carves allocations out of large
+//		blocks taken from a PostgreSQL memory context.
+//
+//---------------------------------------------------------------------------
+
+#ifndef GPDXL_CMemoryPoolArena_H
+#define GPDXL_CMemoryPoolArena_H
+
+#include "gpos/base.h"
+#include "gpos/memory/CMemoryPool.h"
+
+// allocations up to this size are served from the arena blocks; larger ones
+// are passed to palloc directly
+#define GPOPT_ARENA_MAX_CHUNK_SIZE (512)
+
+// number of free lists, one per 8-byte size class
+#define GPOPT_ARENA_NUM_SIZE_CLASSES (GPOPT_ARENA_MAX_CHUNK_SIZE / GPOS_MEM_ARCH)
+
+// size of the first and of the largest arena block
+#define GPOPT_ARENA_MIN_BLOCK_SIZE (1024)
+#define GPOPT_ARENA_MAX_BLOCK_SIZE (64 * 1024)
+
+namespace gpos
+{
+// Memory pool for objects that mostly die together with the pool.
+//
+// Optimization allocates a very large number of small objects (group
+// expressions, column reference sets, derived properties) which are only
+// released when the optimization pool is destroyed. A plain palloc pool pays
+// for a chunk header and power-of-two rounding on each of them. This pool
+// instead bumps a pointer through blocks obtained from its memory context,
+// with a single 8-byte header per allocation.  Objects that are freed early
+// go to a free list for their size class and are reused by the next
+// allocation of that class; the memory itself is only returned to the memory
+// context when the pool is torn down.
+class CMemoryPoolArena : public CMemoryPool
+{
+private:
+	// header of an arena block, followed by the allocations
+	struct SArenaBlock
+	{
+		// pool owning the block
+		CMemoryPoolArena *m_mp;
+
+		// next block of the pool
+		SArenaBlock *m_next;
+	};
+
+	// header preceding each allocation
+	struct SAllocHeader
+	{
+		// user requested size
+		ULONG m_user_size;
+
+		// offset of the header from the start of its arena block,
+		// or 0 for allocations made directly with palloc
+		ULONG m_block_offset;
+	};
+
+	// link stored in the user part of a freed allocation
+	struct SFreeChunk
+	{
+		SFreeChunk *m_next;
+	};
+
+	MemoryContext m_cxt;
+
+	// list of blocks, most recent first
+	SArenaBlock *m_blocks;
+
+	// bump pointer and end of the current block
+	BYTE *m_free_ptr;
+	BYTE *m_end_ptr;
+
+	// size of the next block to allocate
+	ULONG m_next_block_size;
+
+	// free lists of released allocations, by size class
+	SFreeChunk *m_free_lists[GPOPT_ARENA_NUM_SIZE_CLASSES];
+
+	// number of allocation requests served
+	ULLONG m_num_allocations;
+
+	// sum of user requested sizes
+	ULLONG m_user_allocated_size;
+
+	// private copy ctor
+	CMemoryPoolArena(CMemoryPoolArena &);
+
+	// size class of an allocation of given user size
+	static ULONG
+	SizeClass(ULONG user_size)
+	{
+		return (user_size == 0) ? 0
+								: (GPOS_MEM_ALIGNED_SIZE(user_size) /
+									   GPOS_MEM_ARCH -
+								   1);
+	}
+
+	// start a new arena block big enough for the given chunk
+	void NewBlock(ULONG chunk_size);
+
+	// put an arena allocation on its free list
+	void Release(SAllocHeader *header);
+
+public:
+	// ctor
+	CMemoryPoolArena();
+
+	// allocate memory
+	void *NewImpl(const ULONG bytes, const CHAR *file, const ULONG line,
+				  CMemoryPool::EAllocationType eat);
+
+	// free memory
+	static void DeleteImpl(void *ptr, CMemoryPool::EAllocationType eat);
+
+	// prepare the memory pool to be deleted
+	void TearDown();
+
+	// return total allocated size include management overhead
+	ULLONG TotalAllocatedSize() const;
+
+	// return number of allocation requests served
+	virtual ULLONG
+	NumAllocations() const
+	{
+		return m_num_allocations;
+	}
+
+	// return sum of user requested sizes
+	virtual ULLONG
+	UserAllocatedSize() const
+	{
+		return m_user_allocated_size;
+	}
+
+	// get user requested size of allocation
+	static ULONG UserSizeOfAlloc(const void *ptr);
+};
+}  // namespace gpos
+
+#endif	// !GPDXL_CMemoryPoolArena_H
+
+// EOF
@@ -0,0 +1,62 @@
+/*
+ * losertree.h
+ *
+ * A tournament ("loser") tree for k-way merging
+ *
+ * Portions Copyright (c) 2012-Present Pivotal Software, Inc.
+ *
+ * src/include/lib/losertree.h
+ */
+
+#ifndef LOSERTREE_H
+#define LOSERTREE_H
+
+/*
+ * The elements of a loser tree are the integers 0 .. lt_nsources - 1, each
+ * identifying one input stream of the merge.  The caller keeps the current
+ * value of each stream; the comparator is given two stream numbers and must
+ * return >0 iff the current value of a should be returned before that of b,
+ * <0 iff b comes first and 0 if they are equal.  This is the same convention
+ * as for a max-heap built with binaryheap, so comparators can be shared.
+ */
+typedef int (*losertree_comparator) (int a, int b, void *arg);
+
+/*
+ * losertree
+ *
+ *		lt_nsources		number of input streams (leaves of the tree)
+ *		lt_nactive		number of streams that are not exhausted
+ *		lt_winner		stream holding the overall winner, or -1
+ *		lt_built		has losertree_build been called?
+ *		lt_compare		comparison function to define the merge order
+ *		lt_arg			user data for comparison function
+ *		lt_active		which streams currently hold a value
+ *		lt_losers		loser of the match played at each internal node;
+ *						element 0 is unused
+ */
+typedef struct losertree
+{
+	int			lt_nsources;
+	int			lt_nactive;
+	int			lt_winner;
+	bool		lt_built;
+	losertree_comparator lt_compare;
+	void	   *lt_arg;
+	bool	   *lt_active;
+	int			lt_losers[FLEXIBLE_ARRAY_MEMBER];
+} losertree;
+
+extern losertree *losertree_allocate(int nsources,
+				   losertree_comparator compare,
+				   void *arg);
+extern void losertree_reset(losertree *tree);
+extern void losertree_free(losertree *tree);
+extern void losertree_add_unordered(losertree *tree, int source);
+extern void losertree_build(losertree *tree);
+extern int	losertree_first(losertree *tree);
+extern void losertree_replace_first(losertree *tree);
+extern void losertree_remove_first(losertree *tree);
+
+#define losertree_empty(t)			((t)->lt_nactive == 0)
+
+#endif   /* LOSERTREE_H */
@@ -1702,6 +1702,7 @@ typedef struct SeqScanState
 	/* extra state for AOCS scans */
 	bool	   *ss_aocs_proj;
 	int			ss_aocs_ncol;
+	List	   *ss_aocs_qual;	/* qual evaluated inside the AOCS scan, if any */
 } SeqScanState;
 
 /*
@@ -2567,6 +2568,12 @@ typedef struct AggState
 								 * has been calculated in the previous call.
 								 */
 
+	/*
+	 * AGG_PLAIN count(*) over an unqualified append-optimized scan: take
+	 * the count from the scan's metadata instead of reading the tuples.
+	 */
+	bool		count_from_scan;
+
 	/* these fields are used in AGG_PLAIN and AGG_SORTED modes: */
 	AggStatePerGroup pergroup;	/* per-Aggref-per-group working state */
 	struct MemTupleData *grp_firstTuple; /* copy of first tuple of current group */
@@ -2908,7 +2915,7 @@ typedef struct MotionState
 	/* For sorted Motion recv */
 	struct MotionMKHeapContext *tupleheap_mk;		/* data structure for match merge in sorted motion node */
 
-	struct binaryheap *tupleheap;
+	struct losertree *tupleheap;
 	struct CdbTupleHeapInfo *tupleheap_entries;
 	struct CdbMergeComparatorContext *tupleheap_cxt;
 
@@ -232,6 +232,8 @@ PG_KEYWORD("intersect", INTERSECT, RESERVED_KEYWORD)
 PG_KEYWORD("interval", INTERVAL, COL_NAME_KEYWORD)
 PG_KEYWORD("into", INTO, RESERVED_KEYWORD)
 PG_KEYWORD("invoker", INVOKER, UNRESERVED_KEYWORD)
+PG_KEYWORD("io_read_limit", IO_READ_LIMIT, UNRESERVED_KEYWORD)
+PG_KEYWORD("io_write_limit", IO_WRITE_LIMIT, UNRESERVED_KEYWORD)
 PG_KEYWORD("is", IS, TYPE_FUNC_NAME_KEYWORD)
 PG_KEYWORD("isnull", ISNULL, TYPE_FUNC_NAME_KEYWORD)
 PG_KEYWORD("isolation", ISOLATION, UNRESERVED_KEYWORD)
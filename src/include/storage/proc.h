@@ -17,6 +17,7 @@
 #define _PROC_H_
 
 #include "access/xlogdefs.h"
+#include "port/atomics.h"
 #include "storage/latch.h"
 #include "storage/lock.h"
 #include "storage/spin.h"
@@ -284,6 +285,13 @@ typedef struct PROC_HDR
 
     /* Counter for assigning serial numbers to processes */
     int         mppLocalProcessCounter;
+
+	/*
+	 * Bumped whenever a lock wait passes its local deadlock check, i.e. has
+	 * lasted deadlock_timeout.  Lets the global deadlock detector skip
+	 * collecting the wait graph while no wait could close a new cycle.
+	 */
+	pg_atomic_uint32 lockWaitVersion;
 } PROC_HDR;
 
 extern PGDLLIMPORT PROC_HDR *ProcGlobal;
@@ -143,6 +143,7 @@ extern bool DisableCatchupInterrupt(void);
 
 extern volatile int in_process_catchup_event;
 
+extern bool xactHasInvalidationMessages(void);
 extern int xactGetCommittedInvalidationMessages(SharedInvalidationMessage **msgs,
 									 bool *RelcacheInitFileInval);
 extern void ProcessCommittedInvalidationMessages(SharedInvalidationMessage *msgs,
@@ -172,6 +172,7 @@ extern HeapTuple SearchCatCache(CatCache *cache,
 			   Datum v1, Datum v2,
 			   Datum v3, Datum v4);
 extern void ReleaseCatCache(HeapTuple tuple);
+extern int	PrewarmCatCache(CatCache *cache, int nkeys, Datum *keys);
 
 extern uint32 GetCatCacheHashValue(CatCache *cache,
 					 Datum v1, Datum v2,
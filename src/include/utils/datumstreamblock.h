@@ -1101,6 +1101,17 @@ typedef struct DatumStreamBlockRead
 	 */
 	DatumStreamVersion datumStreamVersion;
 
+	/*
+	 * Set when the whole block was decoded when it was read, into
+	 * expanded_values and expanded_isnull (see DatumStreamBlockRead_Expand
+	 * in datumstreamblock.c).  Advance and Get then merely index the arrays
+	 * with nth.
+	 */
+	bool		expanded;
+	Datum	   *expanded_values;
+	bool	   *expanded_isnull;
+	int32		expanded_capacity;
+
 	/* Common current pointer and null bit-map */
 	int32		nth;			/* CURRENT position of datum in the block,
 								 * including NULLs. */
@@ -1225,6 +1236,14 @@ DatumStreamBlockRead_Get(DatumStreamBlockRead * dsr, Datum *datum, bool *null)
 		elog(FATAL, "DatumStreamBlockRead data structure not valid (eyecatcher)");
 #endif
 
+	if (dsr->expanded)
+	{
+		Assert(dsr->nth >= 0 && dsr->nth < dsr->logical_row_count);
+		*null = dsr->expanded_isnull[dsr->nth];
+		*datum = dsr->expanded_values[dsr->nth];
+		return;
+	}
+
 #ifdef USE_ASSERT_CHECKING
 	if ((dsr->datumStreamVersion == DatumStreamVersion_Dense) ||
 		(dsr->datumStreamVersion == DatumStreamVersion_Dense_Enhanced))
@@ -1730,6 +1749,10 @@ DatumStreamBlockRead_AdvanceDense(DatumStreamBlockRead * dsr)
 		if (dsr->nth >= dsr->logical_row_count)
 		return 0;
 
+	/* Already decoded when the block was read */
+	if (dsr->expanded)
+		return 1;
+
 	if (!dsr->rle_block_was_compressed)
 	{
 		/*
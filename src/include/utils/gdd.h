@@ -14,6 +14,7 @@
 #define GDD_H
 
 extern int gp_global_deadlock_detector_period;
+extern int gp_global_deadlock_detector_probe_interval;
 
 extern bool GlobalDeadLockDetectorStartRule(Datum main_arg);
 extern void GlobalDeadLockDetectorMain(Datum main_arg);
@@ -292,14 +292,17 @@ extern bool Debug_datumstream_block_read_check_integrity;
 extern bool Debug_datumstream_block_write_check_integrity;
 extern bool Debug_datumstream_read_print_varlena_info;
 extern bool Debug_datumstream_write_use_small_initial_buffers;
+extern bool gp_datumstream_expand_blocks;
 extern bool	Debug_database_command_print;
 extern bool Debug_resource_group;
 extern bool gp_create_table_random_default_distribution;
 extern bool gp_allow_non_uniform_partitioning_ddl;
 extern bool gp_enable_exchange_default_partition;
 extern int  dtx_phase2_retry_count;
+extern int  gp_dtx_group_commit_delay;
 extern bool gp_log_suboverflow_statement;
 extern bool gp_use_synchronize_seqscans_catalog_vacuum_full;
+extern bool gp_catcache_prewarm;
 
 /* WAL replication debug gucs */
 extern bool debug_walrepl_snd;
@@ -440,6 +443,8 @@ extern int optimizer_minidump;
 extern int  optimizer_cost_model;
 extern bool optimizer_metadata_caching;
 extern int	optimizer_mdcache_size;
+extern int	optimizer_plan_cache_size;
+extern int	optimizer_mdcache_shared_size;
 
 /* Optimizer debugging GUCs */
 extern bool optimizer_print_query;
@@ -540,6 +545,8 @@ extern int optimizer_cte_inlining_bound;
 extern int optimizer_push_group_by_below_setop_threshold;
 extern int optimizer_xform_bind_threshold;
 extern int optimizer_skew_factor;
+extern int optimizer_search_time_budget;
+extern int optimizer_search_memory_budget;
 extern bool optimizer_force_multistage_agg;
 extern bool optimizer_force_three_stage_scalar_dqa;
 extern bool optimizer_force_expanded_distinct_aggs;
@@ -565,6 +572,7 @@ extern bool optimizer_analyze_midlevel_partition;
 extern bool optimizer_analyze_enable_merge_of_leaf_stats;
 
 extern bool optimizer_use_gpdb_allocators;
+extern bool optimizer_use_arena_memory_pools;
 
 /* optimizer GUCs for replicated table */
 extern bool optimizer_replicated_table_insert;
@@ -30,6 +30,8 @@ typedef struct LogicalTapePos
 typedef struct LogicalTape LogicalTape;
 typedef struct LogicalTapeSet LogicalTapeSet;
 
+extern bool gp_logtape_prefetch;	/* GUC */
+
 /*
  * prototypes for functions in logtape.c
  */
@@ -44,6 +44,12 @@ typedef struct MemoryAccountExplain {
  */
 extern int explain_memory_verbosity;
 
+/*
+ * Amount of allocations and frees (in kB) to gather before charging them to
+ * their memory account; 0 charges every chunk as it is allocated or freed.
+ */
+extern int gp_memory_accounting_batch_size;
+
 /*
  * Unique run id for memory profiling. May be just a start timestamp for a batch of queries such as TPCH
  */
@@ -198,6 +204,9 @@ MemoryAccounting_SizeOfAccountInBytes(void);
 extern void
 MemoryAccounting_Reset(void);
 
+extern void
+MemoryAccounting_FlushBatch(MemoryAccountIdType newBatchAccountId);
+
 extern uint32
 MemoryAccounting_Serialize(StringInfoData* buffer);
 
@@ -65,6 +65,15 @@ extern MemoryAccount *SharedChunkHeadersMemoryAccount;
 extern uint64 MemoryAccountingOutstandingBalance;
 extern uint64 MemoryAccountingPeakBalance;
 
+/*
+ * Allocations and frees not yet applied to the account they belong to, when
+ * gp_memory_accounting_batch_size is set. Only one account is batched at a
+ * time; see MemoryAccounting_FlushBatch().
+ */
+extern MemoryAccountIdType MemoryAccountingBatchAccountId;
+extern uint64 MemoryAccountingBatchAllocated;
+extern uint64 MemoryAccountingBatchFreed;
+
 /*
  * MemoryAccounting_IsLiveAccount
  *    Checks if an account is live.
@@ -121,6 +130,20 @@ MemoryAccounting_ConvertIdToAccount(MemoryAccountIdType id)
 	return memoryAccount;
 }
 
+/*
+ * MemoryAccounting_BatchId
+ *    Returns the id under which allocations of an account are batched. All
+ *    dead accounts are charged to the rollover account, so they share its id.
+ */
+static inline MemoryAccountIdType
+MemoryAccounting_BatchId(MemoryAccountIdType id)
+{
+	if (id > MEMORY_OWNER_TYPE_END_LONG_LIVING && id < liveAccountStartId)
+		return MEMORY_OWNER_TYPE_Rollover;
+
+	return id;
+}
+
 /*
  * MemoryAccounting_Allocate
  *	 	When an allocation is made, this function will be called by the
@@ -134,7 +157,28 @@ MemoryAccounting_ConvertIdToAccount(MemoryAccountIdType id)
 static inline bool
 MemoryAccounting_Allocate(MemoryAccountIdType memoryAccountId, Size allocatedSize)
 {
-	MemoryAccount* memoryAccount = MemoryAccounting_ConvertIdToAccount(memoryAccountId);
+	MemoryAccount* memoryAccount;
+
+	/*
+	 * In batched mode, only add to the pending amounts of the batched account
+	 * and update the account once a batch worth of memory has gone through.
+	 */
+	if (gp_memory_accounting_batch_size > 0)
+	{
+		MemoryAccountIdType batchId = MemoryAccounting_BatchId(memoryAccountId);
+
+		if (batchId != MemoryAccountingBatchAccountId)
+			MemoryAccounting_FlushBatch(batchId);
+
+		MemoryAccountingBatchAllocated += allocatedSize;
+		if (MemoryAccountingBatchAllocated + MemoryAccountingBatchFreed >=
+			(uint64) gp_memory_accounting_batch_size * 1024)
+			MemoryAccounting_FlushBatch(batchId);
+
+		return true;
+	}
+
+	memoryAccount = MemoryAccounting_ConvertIdToAccount(memoryAccountId);
 
 	Assert(memoryAccount->allocated + allocatedSize >=
 			memoryAccount->allocated);
@@ -175,7 +219,30 @@ MemoryAccounting_Allocate(MemoryAccountIdType memoryAccountId, Size allocatedSiz
 static inline bool
 MemoryAccounting_Free(MemoryAccountIdType memoryAccountId, Size allocatedSize)
 {
-	MemoryAccount* memoryAccount = MemoryAccounting_ConvertIdToAccount(memoryAccountId);
+	MemoryAccount* memoryAccount;
+
+	/*
+	 * Frees of the batched account are batched as well. Other accounts have no
+	 * pending amounts, but the batch is flushed before charging them: the
+	 * free lowers the outstanding balance, and the pending allocations must
+	 * reach the global peak before that, or the peak may come out too low.
+	 */
+	if (gp_memory_accounting_batch_size > 0)
+	{
+		if (MemoryAccounting_BatchId(memoryAccountId) == MemoryAccountingBatchAccountId)
+		{
+			MemoryAccountingBatchFreed += allocatedSize;
+			if (MemoryAccountingBatchAllocated + MemoryAccountingBatchFreed >=
+				(uint64) gp_memory_accounting_batch_size * 1024)
+				MemoryAccounting_FlushBatch(MemoryAccountingBatchAccountId);
+
+			return true;
+		}
+
+		MemoryAccounting_FlushBatch(MemoryAccountingBatchAccountId);
+	}
+
+	memoryAccount = MemoryAccounting_ConvertIdToAccount(memoryAccountId);
 
 	Assert(memoryAccount->freed +
 			allocatedSize >= memoryAccount->freed);
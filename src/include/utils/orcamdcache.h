@@ -0,0 +1,36 @@
+/*-------------------------------------------------------------------------
+ *
+ * orcamdcache.h
+ *	  Metadata cache shared by the GPORCA instances of all backends.
+ *
+ * Portions Copyright (c) 2012-Present Pivotal Software, Inc.
+ *
+ * src/include/utils/orcamdcache.h
+ *
+ *-------------------------------------------------------------------------
+ */
+#ifndef ORCAMDCACHE_H
+#define ORCAMDCACHE_H
+
+/*
+ * Cache versions observed by a backend when it looked up an object and
+ * missed.  The object fetched from the catalogs afterwards is only added to
+ * the shared cache if no catalog change can have happened in between.
+ */
+typedef struct OrcaMDCacheVersion
+{
+	uint64		generation;		/* shared generation at lookup */
+	uint64		local_invals;	/* this backend's invalidation count */
+} OrcaMDCacheVersion;
+
+extern Size OrcaMDCacheShmemSize(void);
+extern void OrcaMDCacheShmemInit(void);
+extern void OrcaMDCacheInitBackend(void);
+
+extern char *OrcaMDCacheLookup(int mdtype, const char *mdid, Size *len,
+				  OrcaMDCacheVersion *version);
+extern void OrcaMDCacheInsert(int mdtype, const char *mdid,
+				  const OrcaMDCacheVersion *version,
+				  const char *data, Size len);
+
+#endif   /* ORCAMDCACHE_H */
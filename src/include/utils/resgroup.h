@@ -50,6 +50,12 @@
  */
 #define RESGROUP_FALLBACK_MEMORY_SPILL_RATIO		(0)
 
+/*
+ * When setting io_read_limit or io_write_limit to 0 the disk bandwidth of the
+ * group is not throttled.
+ */
+#define RESGROUP_UNLIMITED_IO_LIMIT		(0)
+
 /*
  * Resource group capability.
  */
@@ -82,11 +88,17 @@ typedef struct ResGroupCaps
 	ResGroupCap		memSpillRatio;
 	ResGroupCap		memAuditor;
 	char			cpuset[MaxCpuSetLength];
+
+	/* caps added after cpuset, can't be accessed via index */
+	ResGroupCap		ioReadLimit;
+	ResGroupCap		ioWriteLimit;
 } ResGroupCaps;
 
 /* Set 'cpuset' to an empty string, and reset all other fields to zero */
 #define ClearResGroupCaps(caps) do { \
 	MemSet((caps), 0, offsetof(ResGroupCaps, cpuset) + 1); \
+	(caps)->ioReadLimit = 0; \
+	(caps)->ioWriteLimit = 0; \
 } while(0)
 
 
@@ -183,6 +195,9 @@ extern void ResGroupDumpMemoryInfo(void);
 extern bool ResGroupReserveMemory(int32 memoryChunks, int32 overuseChunks, bool *waiverUsed);
 /* Update the memory usage of resource group */
 extern void ResGroupReleaseMemory(int32 memoryChunks);
+/* Charge disk io to resource group, and enforce its io limits */
+extern void ResGroupThrottleIO(Size bytes, bool isWrite);
+extern void ResGroupGetIOUsage(Oid groupId, uint64 *readBytes, uint64 *writeBytes);
 
 extern void ResGroupDropFinish(const ResourceGroupCallbackContext *callbackCtx,
 							   bool isCommit);
@@ -17,10 +17,15 @@
 		"gp_allow_date_field_width_5digits",
 		"gp_blockdirectory_entry_min_range",
 		"gp_blockdirectory_minipage_size",
+		"gp_catcache_prewarm",
+		"gp_datumstream_expand_blocks",
 		"gp_debug_linger",
 		"gp_default_storage_options",
 		"gp_detect_data_correctness",
 		"gp_disable_tuple_hints",
+		"gp_dtx_group_commit_delay",
+		"gp_enable_ao_count_pushdown",
+		"gp_enable_aocs_late_materialization",
 		"gp_enable_mk_sort",
 		"gp_enable_motion_mk_sort",
 		"gp_enable_segment_copy_checking",
@@ -57,8 +62,10 @@
 		"gp_log_resqueue_memory",
 		"gp_log_stack_trace_lines",
 		"gp_log_suboverflow_statement",
+		"gp_logtape_prefetch",
 		"gp_max_packet_size",
 		"gp_max_partition_level",
+		"gp_memory_accounting_batch_size",
 		"gp_mk_sort_check",
 		"gp_motion_slice_noop",
 		"gp_partitioning_dynamic_selection_log",
@@ -104,8 +111,11 @@
 		"optimizer_cte_inlining_bound",
 		"optimizer_mdcache_size",
 		"optimizer_partition_selection_log",
+		"optimizer_plan_cache_size",
 		"optimizer_plan_id",
 		"optimizer_push_group_by_below_setop_threshold",
+		"optimizer_search_memory_budget",
+		"optimizer_search_time_budget",
 		"optimizer_xform_bind_threshold",
 		"optimizer_samples_number",
 		"planner_work_mem",
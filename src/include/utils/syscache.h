@@ -130,6 +130,8 @@ extern Datum SysCacheGetAttr(int cacheId, HeapTuple tup,
 extern uint32 GetSysCacheHashValue(int cacheId,
 					 Datum key1, Datum key2, Datum key3, Datum key4);
 
+extern int	PrewarmSysCache(int cacheId, int nkeys, Datum *keys);
+
 /* list-search interface.  Users of this must import catcache.h too */
 struct catclist;
 extern struct catclist *SearchSysCacheList(int cacheId, int nkeys,
@@ -207,6 +207,7 @@
 		"gp_gang_creation_retry_non_recovery",
 		"gp_gang_creation_retry_timer",
 		"gp_global_deadlock_detector_period",
+		"gp_global_deadlock_detector_probe_interval",
 		"gp_hashagg_streambottom",
 		"gp_heap_require_relhasoids_match",
 		"gp_ignore_window_exclude",
@@ -425,6 +426,7 @@
 		"optimizer_join_order_threshold",
 		"optimizer_log",
 		"optimizer_log_failure",
+		"optimizer_mdcache_shared_size",
 		"optimizer_metadata_caching",
 		"optimizer_minidump",
 		"optimizer_multilevel_partitioning",
@@ -457,6 +459,7 @@
 		"optimizer_sort_factor",
 		"optimizer_trace_fallback",
 		"optimizer_skew_factor",
+		"optimizer_use_arena_memory_pools",
 		"optimizer_use_external_constant_expression_evaluation_for_ints",
 		"optimizer_use_gpdb_allocators",
 		"password_encryption",
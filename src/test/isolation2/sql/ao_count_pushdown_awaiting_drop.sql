@@ -0,0 +1,34 @@
+-- count(*) answered from the segment file metadata of an append-optimized
+-- table must not count the rows of segment files awaiting drop after
+-- compaction, since their live rows have been moved to another segment file.
+
+CREATE TABLE ao_count_awaiting_drop_row (a int) WITH (appendonly=true) DISTRIBUTED BY (a);
+CREATE TABLE ao_count_awaiting_drop_col (a int) WITH (appendonly=true, orientation=column) DISTRIBUTED BY (a);
+INSERT INTO ao_count_awaiting_drop_row SELECT i FROM generate_series(1, 100)i;
+INSERT INTO ao_count_awaiting_drop_col SELECT i FROM generate_series(1, 100)i;
+DELETE FROM ao_count_awaiting_drop_row WHERE a <= 50;
+DELETE FROM ao_count_awaiting_drop_col WHERE a <= 50;
+
+-- VACUUM while another session holds lock, so that the compacted
+-- segment files cannot be dropped
+1: BEGIN;
+1: SELECT COUNT(*) FROM ao_count_awaiting_drop_row;
+1: SELECT COUNT(*) FROM ao_count_awaiting_drop_col;
+2: VACUUM ao_count_awaiting_drop_row;
+2: VACUUM ao_count_awaiting_drop_col;
+1: END;
+
+-- We should see segno 1 in state 2 (AOSEG_STATE_AWAITING_DROP)
+0U: SELECT segno, state FROM gp_toolkit.__gp_aoseg('ao_count_awaiting_drop_row');
+0U: SELECT segno, column_num, state FROM gp_toolkit.__gp_aocsseg('ao_count_awaiting_drop_col');
+
+-- The counts with and without the pushdown agree
+SELECT COUNT(*) FROM ao_count_awaiting_drop_row;
+SELECT COUNT(*) FROM ao_count_awaiting_drop_col;
+SET gp_enable_ao_count_pushdown = off;
+SELECT COUNT(*) FROM ao_count_awaiting_drop_row;
+SELECT COUNT(*) FROM ao_count_awaiting_drop_col;
+RESET gp_enable_ao_count_pushdown;
+
+DROP TABLE ao_count_awaiting_drop_row;
+DROP TABLE ao_count_awaiting_drop_col;
@@ -0,0 +1,48 @@
+-- With probes on, a distributed deadlock is broken soon after its waits
+-- pass deadlock_timeout, long before gp_global_deadlock_detector_period.
+ALTER SYSTEM RESET gp_global_deadlock_detector_period;
+ALTER SYSTEM SET gp_global_deadlock_detector_probe_interval TO 500;
+SELECT pg_reload_conf();
+-- start new session, which should always have newly reflected value
+1: SHOW gp_global_deadlock_detector_period;
+1: SHOW gp_global_deadlock_detector_probe_interval;
+
+DROP TABLE IF EXISTS tprobe;
+CREATE TABLE tprobe (id int, val int);
+INSERT INTO tprobe (id, val) SELECT i, i FROM generate_series(1, 100) i;
+DROP TABLE IF EXISTS tprobe_start;
+CREATE TABLE tprobe_start (t timestamptz);
+
+-- gang creation order is important, reset any guc to force the creation
+10: RESET optimizer;
+20: RESET optimizer;
+
+10: BEGIN;
+20: BEGIN;
+
+10: UPDATE tprobe SET val=val WHERE id=segid(0,1);
+
+20: UPDATE tprobe SET val=val WHERE id=segid(1,1);
+
+INSERT INTO tprobe_start SELECT clock_timestamp();
+
+-- seg 0: con20 ==> con10, xid lock
+20&: UPDATE tprobe SET val=val WHERE id=segid(0,1);
+
+-- seg 1: con10 ==> con20, xid lock
+10>: UPDATE tprobe SET val=val WHERE id=segid(1,1);
+
+-- con20 will be cancelled by gdd
+20<:
+20q:
+
+-- no more deadlock
+10<:
+10q:
+
+-- broken well before the 2min period
+SELECT clock_timestamp() - t < interval '30 seconds' FROM tprobe_start;
+
+ALTER SYSTEM SET gp_global_deadlock_detector_period TO 5;
+ALTER SYSTEM RESET gp_global_deadlock_detector_probe_interval;
+SELECT pg_reload_conf();
@@ -2,6 +2,7 @@ include: helpers/server_helpers.sql;
 
 ALTER SYSTEM RESET gp_enable_global_deadlock_detector;
 ALTER SYSTEM RESET gp_global_deadlock_detector_period;
+ALTER SYSTEM RESET gp_global_deadlock_detector_probe_interval;
 
 -- Use utility session on seg 0 to restart master. This way avoids the
 -- situation where session issuing the restart doesn't disappear
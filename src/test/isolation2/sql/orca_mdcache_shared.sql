@@ -0,0 +1,61 @@
+-- The MDCache shared across sessions must not hand out relation statistics
+-- that were changed since they were cached, even when they were changed
+-- in place by VACUUM, without a transaction id.
+include: helpers/server_helpers.sql;
+
+-- table to just store the master's data directory path on segment.
+CREATE TABLE mdcache_datadir(a int, dir text);
+INSERT INTO mdcache_datadir select 1,datadir from gp_segment_configuration where role='p' and content=-1;
+
+-- estimated number of rows of a scan of the given table
+CREATE OR REPLACE FUNCTION mdcache_rows(tab text) RETURNS float8 AS $$
+DECLARE
+	line text;
+BEGIN
+	FOR line IN EXECUTE 'EXPLAIN SELECT * FROM ' || tab LOOP
+		RETURN substring(line from 'rows=([0-9.]+)')::float8;
+	END LOOP;
+END
+$$ LANGUAGE plpgsql;
+
+5: ALTER SYSTEM SET optimizer_mdcache_shared_size TO '8MB';
+-- close session to avoid renew session failure after restart
+5q:
+-- Use utility session on seg 0 to restart master. This way avoids the
+-- situation where session issuing the restart doesn't disappear
+-- itself.
+1U:SELECT pg_ctl(dir, 'restart') from mdcache_datadir;
+
+1: SHOW optimizer_mdcache_shared_size;
+1: CREATE TABLE mdcache_t (a int, b int) DISTRIBUTED BY (a);
+1: INSERT INTO mdcache_t SELECT i, i FROM generate_series(1, 100) i;
+1: ANALYZE mdcache_t;
+
+-- warm the shared cache
+1: SET optimizer TO on;
+1: SELECT mdcache_rows('mdcache_t') < 1000;
+1q:
+
+2: SET optimizer TO on;
+2: SELECT mdcache_rows('mdcache_t') < 1000;
+2q:
+
+-- VACUUM updates reltuples in place
+3: INSERT INTO mdcache_t SELECT i, i FROM generate_series(1, 100000) i;
+3: VACUUM mdcache_t;
+3q:
+
+-- a new session must see the new row count
+4: SET optimizer TO on;
+4: SELECT mdcache_rows('mdcache_t') > 1000;
+4: DROP TABLE mdcache_t;
+4q:
+
+5: ALTER SYSTEM RESET optimizer_mdcache_shared_size;
+5q:
+1U:SELECT pg_ctl(dir, 'restart') from mdcache_datadir;
+
+1: SHOW optimizer_mdcache_shared_size;
+1: DROP TABLE mdcache_datadir;
+1: DROP FUNCTION mdcache_rows(text);
+1q:
@@ -0,0 +1,47 @@
+-- test io_write_limit: an append-only insert of a resource group limited to
+-- 1MB/s per segment is slowed down to about that rate, and its writes show
+-- in the io_usage of gp_resgroup_status while it runs.
+DROP ROLE IF EXISTS role_io_limit_test;
+-- start_ignore
+DROP RESOURCE GROUP rg_io_limit_test;
+-- end_ignore
+CREATE RESOURCE GROUP rg_io_limit_test WITH (cpu_rate_limit=10, memory_limit=10, io_write_limit=1);
+CREATE ROLE role_io_limit_test RESOURCE GROUP rg_io_limit_test;
+
+CREATE TABLE rg_io_limit_ao (a int, b text) WITH (appendonly=true) DISTRIBUTED BY (a);
+GRANT ALL ON rg_io_limit_ao TO role_io_limit_test;
+CREATE TABLE rg_io_limit_start (t timestamptz);
+
+-- wait up to 10 seconds for the group to report a write rate on a segment
+CREATE OR REPLACE FUNCTION rg_io_limit_writing() RETURNS bool AS $$
+DECLARE
+	writing bool; /* in func */
+BEGIN
+	FOR i IN 1..100 LOOP
+		SELECT bool_or((u.value->>'write')::float > 0) INTO writing
+		  FROM gp_toolkit.gp_resgroup_status s, json_each(s.io_usage) u
+		 WHERE s.rsgname = 'rg_io_limit_test'; /* in func */
+		IF writing THEN
+			RETURN true; /* in func */
+		END IF; /* in func */
+		PERFORM pg_sleep(0.1); /* in func */
+	END LOOP; /* in func */
+	RETURN false; /* in func */
+END; /* in func */
+$$ LANGUAGE plpgsql;
+
+1:SET ROLE role_io_limit_test;
+INSERT INTO rg_io_limit_start SELECT clock_timestamp();
+-- about 4MB per segment on a three-segment cluster
+1&:INSERT INTO rg_io_limit_ao SELECT i, repeat('x', 1000) FROM generate_series(1, 12000) i;
+SELECT rg_io_limit_writing();
+1<:
+-- writing that much at 1MB/s takes a few seconds
+SELECT clock_timestamp() - t > interval '2 seconds' AS throttled FROM rg_io_limit_start;
+1q:
+
+DROP FUNCTION rg_io_limit_writing();
+DROP TABLE rg_io_limit_start;
+DROP TABLE rg_io_limit_ao;
+DROP ROLE role_io_limit_test;
+DROP RESOURCE GROUP rg_io_limit_test;
@@ -169,6 +169,18 @@ DROP RESOURCE GROUP rg_test_group;
 CREATE RESOURCE GROUP rg_test_group WITH (cpu_rate_limit=10, memory_limit=10, memory_shared_quota=10, memory_spill_ratio=-1);
 CREATE RESOURCE GROUP rg_test_group WITH (cpu_rate_limit=10, memory_limit=10, memory_shared_quota=-1, memory_spill_ratio=10);
 
+-- io_read_limit & io_write_limit range is [0, 1048576], 0 means unlimited
+-- and is not stored
+CREATE RESOURCE GROUP rg_test_group WITH (cpu_rate_limit=10, memory_limit=10, io_read_limit=100);
+SELECT reslimittype, value FROM pg_resgroupcapability c, pg_resgroup g WHERE c.resgroupid = g.oid AND g.rsgname = 'rg_test_group' AND reslimittype >= 8 ORDER BY reslimittype;
+ALTER RESOURCE GROUP rg_test_group SET io_write_limit 50;
+ALTER RESOURCE GROUP rg_test_group SET io_read_limit 0;
+SELECT reslimittype, value FROM pg_resgroupcapability c, pg_resgroup g WHERE c.resgroupid = g.oid AND g.rsgname = 'rg_test_group' AND reslimittype >= 8 ORDER BY reslimittype;
+ALTER RESOURCE GROUP rg_test_group SET io_write_limit -1;
+ALTER RESOURCE GROUP rg_test_group SET io_read_limit 1048577;
+DROP RESOURCE GROUP rg_test_group;
+CREATE RESOURCE GROUP rg_test_group WITH (cpu_rate_limit=10, memory_limit=10, io_write_limit=-1);
+
 -- positive: cpu_rate_limit & memory_limit should be in [1, 100]
 CREATE RESOURCE GROUP rg_test_group WITH (cpu_rate_limit=60, memory_limit=10);
 DROP RESOURCE GROUP rg_test_group;
@@ -46,6 +46,7 @@
 #include "parser/parse_expr.h"
 #include "storage/bufmgr.h"
 #include "storage/buf_internals.h"
+#include "tcop/tcopprot.h"
 #include "libpq/auth.h"
 #include "libpq/hba.h"
 #include "utils/builtins.h"
@@ -107,6 +108,9 @@ extern Datum check_shared_buffer_cache_for_dboid(PG_FUNCTION_ARGS);
 extern Datum gp_set_next_oid(PG_FUNCTION_ARGS);
 extern Datum gp_get_next_oid(PG_FUNCTION_ARGS);
 
+/* catalog cache prewarming */
+extern Datum gp_catalog_prewarmed(PG_FUNCTION_ARGS);
+
 /* Broken output function, for testing */
 extern Datum broken_int4out(PG_FUNCTION_ARGS);
 
@@ -2129,6 +2133,19 @@ gp_get_next_oid(PG_FUNCTION_ARGS)
 	PG_RETURN_OID(ShmemVariableCache->nextOid);
 }
 
+/*
+ * Number of catalog entries this segment prewarmed for the plan being
+ * executed (gp_catcache_prewarm).
+ *
+ * Used in the 'catcache_prewarm' test.
+ */
+PG_FUNCTION_INFO_V1(gp_catalog_prewarmed);
+Datum
+gp_catalog_prewarmed(PG_FUNCTION_ARGS)
+{
+	PG_RETURN_INT32(PlanCatalogPrewarmed);
+}
+
 /*
  * This is like int4out, but throws an error on '1234'.
  *
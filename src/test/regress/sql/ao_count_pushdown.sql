@@ -0,0 +1,86 @@
+--
+-- An ungrouped count(*) directly over an unqualified scan of an
+-- append-optimized table is answered from the segment file tuple counts and
+-- the visibility map (gp_enable_ao_count_pushdown).  Check that the result
+-- always matches what a real scan returns, and that the scan is skipped.
+--
+create table ao_count_row (a int, b int) with (appendonly=true) distributed by (a);
+create table ao_count_col (a int, b int) with (appendonly=true, orientation=column) distributed by (a);
+
+insert into ao_count_row select i, i from generate_series(1, 1000) i;
+insert into ao_count_col select i, i from generate_series(1, 1000) i;
+delete from ao_count_row where a <= 100;
+delete from ao_count_col where a <= 100;
+update ao_count_row set b = b + 1 where a <= 200;
+update ao_count_col set b = b + 1 where a <= 200;
+
+-- rows of an aborted insert are not counted
+begin;
+insert into ao_count_row select i, i from generate_series(1, 1000) i;
+insert into ao_count_col select i, i from generate_series(1, 1000) i;
+abort;
+
+select count(*) from ao_count_row;
+select count(*) from ao_count_col;
+select count(*), count(*) + 1 from ao_count_row having count(*) > 0;
+select count(*) from ao_count_col having count(*) < 0;
+
+-- the same counts when the tables are actually scanned
+set gp_enable_ao_count_pushdown = off;
+select count(*) from ao_count_row;
+select count(*) from ao_count_col;
+reset gp_enable_ao_count_pushdown;
+
+-- with the pushdown, the scan below the count never runs
+create function ao_count_scan_skipped(query text) returns bool as $$
+declare
+	ln text;
+begin
+	for ln in execute 'explain analyze ' || query loop
+		if ln like '%Seq Scan on%' then
+			return ln like '%(never executed)%';
+		end if;
+	end loop;
+	return null;
+end;
+$$ language plpgsql;
+select ao_count_scan_skipped('select count(*) from ao_count_row');
+select ao_count_scan_skipped('select count(*) from ao_count_col');
+-- but it does when the rows are needed, or for heap tables
+select ao_count_scan_skipped('select count(*) from ao_count_row where b > 0');
+select ao_count_scan_skipped('select count(b) from ao_count_col');
+create table ao_count_heap (a int, b int) distributed by (a);
+insert into ao_count_heap select i, i from generate_series(1, 10) i;
+select ao_count_scan_skipped('select count(*) from ao_count_heap');
+-- or when the scan evaluates a volatile function for each row
+create sequence ao_count_seq;
+select count(*) from (select nextval('ao_count_seq') from ao_count_row) t;
+select nextval('ao_count_seq') > 900 as seq_advanced;
+select ao_count_scan_skipped('select count(*) from (select nextval(''ao_count_seq'') from ao_count_col) t');
+drop sequence ao_count_seq;
+set gp_enable_ao_count_pushdown = off;
+select ao_count_scan_skipped('select count(*) from ao_count_row');
+reset gp_enable_ao_count_pushdown;
+
+-- deletes of the current transaction are taken into account
+begin;
+delete from ao_count_row where a <= 300;
+delete from ao_count_col where a <= 300;
+select count(*) from ao_count_row;
+select count(*) from ao_count_col;
+set local gp_enable_ao_count_pushdown = off;
+select count(*) from ao_count_row;
+select count(*) from ao_count_col;
+abort;
+
+-- compacted segment files are not counted; the awaiting drop state is
+-- covered by the isolation2 test ao_count_pushdown_awaiting_drop
+vacuum ao_count_row;
+vacuum ao_count_col;
+select count(*) from ao_count_row;
+select count(*) from ao_count_col;
+
+drop function ao_count_scan_skipped(text);
+drop table ao_count_heap;
+drop table ao_count_row;
+drop table ao_count_col;
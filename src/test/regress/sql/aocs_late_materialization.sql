@@ -0,0 +1,37 @@
+--
+-- With gp_enable_aocs_late_materialization, a sequential scan on a
+-- column-oriented table reads the columns its filter needs first, and the
+-- other columns only for rows that pass.  Check that the results are the
+-- same as with the columns read in lockstep.
+--
+create table aocs_lm (a int, b text, c int, d int)
+  with (appendonly=true, orientation=column, compresstype=zlib, blocksize=8192)
+  distributed by (a);
+
+insert into aocs_lm select i, repeat('x', i % 100), i * 2, i % 7 from generate_series(1, 10000) i;
+
+select count(*), sum(c) as sum_c, sum(length(b)) as sum_len from aocs_lm where a % 1000 = 7;
+select a, c, length(b) from aocs_lm where a between 4998 and 5002 order by a;
+-- filter on a column other than the first
+select a, d from aocs_lm where c = 3000;
+-- filter needs all the projected columns
+select count(*) from aocs_lm where c = 2 * a;
+
+-- deleted rows are skipped before the filter is evaluated
+delete from aocs_lm where a % 1000 = 7 and a > 5000;
+select count(*), sum(c) as sum_c, sum(length(b)) as sum_len from aocs_lm where a % 1000 = 7;
+
+-- values stored as large objects
+insert into aocs_lm select i, repeat('y', 100000), i * 2, i % 7 from generate_series(10001, 10010) i;
+select a, length(b) from aocs_lm where a in (10003, 10008) order by a;
+select a, length(b), d from aocs_lm where c = 20014;
+select count(*), sum(length(b)) as sum_len from aocs_lm where c > 20000;
+
+-- the same results with all columns read for every row
+set gp_enable_aocs_late_materialization = off;
+select count(*), sum(c) as sum_c, sum(length(b)) as sum_len from aocs_lm where a % 1000 = 7;
+select a, c, length(b) from aocs_lm where a between 4998 and 5002 order by a;
+select a, length(b), d from aocs_lm where c = 20014;
+reset gp_enable_aocs_late_materialization;
+
+drop table aocs_lm;
@@ -0,0 +1,41 @@
+--
+-- GPORCA plan cache (optimizer_plan_cache_size).  Repeated queries reuse
+-- the cached plan; check that the plan is dropped when the tables or the
+-- settings it was made for change.  With gp_log_optimization_time, GPORCA
+-- logs each reuse.  Without GPORCA, this just runs the queries.
+--
+-- start_matchignore
+-- m/^LOG:  (Optimizer|Planner) Time: /
+-- end_matchignore
+set optimizer_plan_cache_size = 10;
+create table orca_plan_cache (a int, b int) distributed by (a);
+insert into orca_plan_cache select i % 4, i from generate_series(1, 40) i;
+set log_statement = 'none';
+set log_min_duration_statement = -1;
+set gp_log_optimization_time = on;
+set client_min_messages = 'log';
+select a, count(*) from orca_plan_cache group by a order by a;
+select a, count(*) from orca_plan_cache group by a order by a;
+-- new data is seen by a cached plan
+insert into orca_plan_cache select i % 4, i from generate_series(1, 4) i;
+select a, count(*) from orca_plan_cache group by a order by a;
+-- resizing the cache keeps the cached plans
+set optimizer_plan_cache_size = 20;
+select a, count(*) from orca_plan_cache group by a order by a;
+-- the plan above needs no Motion below the aggregate, because the table is
+-- distributed by the grouping column.  Redistributing the table must not
+-- reuse it.
+alter table orca_plan_cache set distributed randomly;
+select a, count(*) from orca_plan_cache group by a order by a;
+-- a change of settings is planned from scratch
+set optimizer_enable_hashagg = off;
+select a, count(*) from orca_plan_cache group by a order by a;
+reset optimizer_enable_hashagg;
+set optimizer_plan_cache_size = 0;
+select a, count(*) from orca_plan_cache group by a order by a;
+reset optimizer_plan_cache_size;
+reset client_min_messages;
+reset gp_log_optimization_time;
+reset log_min_duration_statement;
+reset log_statement;
+drop table orca_plan_cache;
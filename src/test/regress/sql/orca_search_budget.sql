@@ -0,0 +1,51 @@
+--
+-- GPORCA search budget (optimizer_search_time_budget and
+-- optimizer_search_memory_budget).  When the budget runs out before any
+-- plan is complete, GPORCA completes one in a rescue stage that may use half
+-- of each budget again; if that runs out too, GPORCA falls back to the
+-- Postgres planner.  GPORCA logs each of these steps.  Without GPORCA, this
+-- just runs the queries.
+--
+-- start_matchsubs
+-- m/\[OPT\]: Search budget exhausted in stage/
+-- s/^.*\[OPT\]: Search budget exhausted in stage \d+ after \d+ msec and \d+ KB.*/[OPT]: Search budget exhausted/
+-- m/\[OPT\]: Completing the plan in rescue stage/
+-- s/^.*\[OPT\]: Completing the plan in rescue stage \d+.*/[OPT]: Completing the plan in rescue stage/
+-- m/\[OPT\]: Rescue stage \d+ exhausted its memory budget/
+-- s/^.*\[OPT\]: Rescue stage \d+ exhausted its memory budget at \d+ KB.*/[OPT]: Rescue stage exhausted its memory budget/
+-- m/\[OPT\]: Rescue stage \d+ found no plan/
+-- s/^.*\[OPT\]: Rescue stage \d+ found no plan within its budget.*/[OPT]: Rescue stage found no plan within its budget/
+-- end_matchsubs
+create table orca_search_budget (a int, b int) distributed by (a);
+insert into orca_search_budget select i, i % 5 from generate_series(1, 20) i;
+set optimizer_trace_fallback = on;
+-- a budget of 1 kB is exhausted before the first plan is complete, and half
+-- of it is not enough for the rescue stage either
+set optimizer_search_memory_budget = 1;
+set log_statement = 'none';
+set log_min_duration_statement = -1;
+set client_min_messages = 'log';
+select count(*) from orca_search_budget t1
+  join orca_search_budget t2 on t1.a = t2.a
+  join orca_search_budget t3 on t2.a = t3.a
+  join orca_search_budget t4 on t3.a = t4.a
+  join orca_search_budget t5 on t4.b = t5.a
+  join orca_search_budget t6 on t5.b = t6.a
+  where t1.b < 3;
+reset client_min_messages;
+reset log_min_duration_statement;
+reset log_statement;
+reset optimizer_search_memory_budget;
+-- whether 1 ms is enough to find a plan, in the first stages or in the
+-- rescue stage, depends on the machine; the result is the same either way
+reset optimizer_trace_fallback;
+set optimizer_search_time_budget = 1;
+select count(*) from orca_search_budget t1
+  join orca_search_budget t2 on t1.a = t2.a
+  join orca_search_budget t3 on t2.a = t3.a
+  join orca_search_budget t4 on t3.a = t4.a
+  join orca_search_budget t5 on t4.b = t5.a
+  join orca_search_budget t6 on t5.b = t6.a
+  where t1.b < 3;
+reset optimizer_search_time_budget;
+drop table orca_search_budget;